@@ -0,0 +1,60 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// the project is compiled for the baseline instruction set of the target platform; only the
+// kernels declared with CAGD_TARGET_AVX2 may contain AVX2 and FMA instructions, and they have
+// to be called only if ProcessorSupportsAVX2() holds, i.e., the same executable runs on every
+// x86 processor and selects the vectorized code paths at run time
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CAGD_AVX2_KERNELS 1
+#define CAGD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+// MSVC accepts the intrinsics of every instruction set without any compiler option
+#define CAGD_AVX2_KERNELS 1
+#define CAGD_TARGET_AVX2
+#else
+#define CAGD_AVX2_KERNELS 0
+#define CAGD_TARGET_AVX2
+#endif
+
+namespace cagd
+{
+    inline GLboolean _DetectAVX2()
+    {
+#if CAGD_AVX2_KERNELS && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? GL_TRUE : GL_FALSE;
+#elif CAGD_AVX2_KERNELS
+        int info[4];
+
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return GL_FALSE;
+
+        // FMA, OSXSAVE and AVX, moreover the operating system has to save the ymm registers
+        __cpuid(info, 1);
+        const int required = (1 << 12) | (1 << 27) | (1 << 28);
+        if ((info[2] & required) != required || (_xgetbv(0) & 6) != 6)
+            return GL_FALSE;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) ? GL_TRUE : GL_FALSE;
+#else
+        return GL_FALSE;
+#endif
+    }
+
+    // does the processor support AVX2 and FMA (the result is determined only once)
+    inline GLboolean ProcessorSupportsAVX2()
+    {
+        static const GLboolean supported = _DetectAVX2();
+        return supported;
+    }
+}
@@ -0,0 +1,122 @@
+#include "FastFourierTransforms.h"
+#include "Constants.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace cagd;
+using namespace std;
+
+GLboolean FastFourierTransform::IsPowerOfTwo(GLuint n)
+{
+    return n && !(n & (n - 1));
+}
+
+GLvoid FastFourierTransform::Transform(vector<Complex>& x, GLboolean inverse)
+{
+    GLuint n = (GLuint)x.size();
+    if (n <= 1)
+        return;
+
+    if (IsPowerOfTwo(n))
+    {
+        _Radix2(x, inverse);
+    }
+    else
+    {
+        // the inverse transform is the conjugate of the forward transform of the conjugates
+        if (inverse)
+            for (Complex& value : x)
+                value = conj(value);
+
+        _Bluestein(x);
+
+        if (inverse)
+            for (Complex& value : x)
+                value = conj(value);
+    }
+
+    if (inverse)
+    {
+        GLdouble scale = 1.0 / n;
+        for (Complex& value : x)
+            value *= scale;
+    }
+}
+
+GLvoid FastFourierTransform::_Radix2(vector<Complex>& x, GLboolean inverse)
+{
+    GLuint n = (GLuint)x.size();
+
+    // bit reversal permutation
+    for (GLuint i = 1, j = 0; i < n; ++i)
+    {
+        GLuint bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+
+        if (i < j)
+            swap(x[i], x[j]);
+    }
+
+    // butterflies, the twiddle factors of a stage are calculated directly (and not by repeated
+    // multiplication) in order to avoid the accumulation of rounding errors
+    GLdouble sign = inverse ? 1.0 : -1.0;
+    for (GLuint length = 2; length <= n; length <<= 1)
+    {
+        GLuint half = length >> 1;
+        GLdouble angle = sign * TWO_PI / length;
+
+        for (GLuint k = 0; k < half; ++k)
+        {
+            GLdouble w_re = cos(angle * k), w_im = sin(angle * k);
+            for (GLuint i = k; i < n; i += length)
+            {
+                // the product is expanded by hand, since operator * of std::complex has to handle
+                // infinities and NaNs, that prevents its inlining
+                const Complex &y = x[i + half];
+                Complex t(w_re * y.real() - w_im * y.imag(), w_re * y.imag() + w_im * y.real());
+                x[i + half] = x[i] - t;
+                x[i] += t;
+            }
+        }
+    }
+}
+
+GLvoid FastFourierTransform::_Bluestein(vector<Complex>& x)
+{
+    GLuint n = (GLuint)x.size();
+
+    GLuint m = 1;
+    while (m < 2 * n - 1)
+        m <<= 1;
+
+    // chirp w_k = exp(-pi i k^2 / n), the exponent is reduced modulo 2n before the evaluation
+    vector<Complex> chirp(n);
+    for (GLuint k = 0; k < n; ++k)
+    {
+        unsigned long long k2 = ((unsigned long long)k * k) % (2ull * n);
+        GLdouble angle = -PI * (GLdouble)k2 / n;
+        chirp[k] = Complex(cos(angle), sin(angle));
+    }
+
+    vector<Complex> a(m), b(m);
+    for (GLuint k = 0; k < n; ++k)
+        a[k] = x[k] * chirp[k];
+
+    b[0] = conj(chirp[0]);
+    for (GLuint k = 1; k < n; ++k)
+        b[k] = b[m - k] = conj(chirp[k]);
+
+    // circular convolution of length m
+    _Radix2(a, GL_FALSE);
+    _Radix2(b, GL_FALSE);
+    for (GLuint k = 0; k < m; ++k)
+        a[k] *= b[k];
+    _Radix2(a, GL_TRUE);
+
+    GLdouble scale = 1.0 / m;
+    for (GLuint k = 0; k < n; ++k)
+        x[k] = a[k] * chirp[k] * scale;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <complex>
+#include <vector>
+
+namespace cagd
+{
+    // discrete Fourier transforms of arbitrary length in O(N log N) operations: power of two
+    // lengths are transformed by the iterative radix-2 algorithm, other lengths by Bluestein's
+    // chirp-z algorithm (i.e., by a radix-2 convolution of length at least 2N - 1)
+    class FastFourierTransform
+    {
+    public:
+        typedef std::complex<GLdouble> Complex;
+
+        // in-place forward transform X_m = sum_{j=0}^{N-1} x_j exp(-2 pi i j m / N), or inverse
+        // transform x_j = (1 / N) sum_{m=0}^{N-1} X_m exp(2 pi i j m / N)
+        static GLvoid Transform(std::vector<Complex>& x, GLboolean inverse = GL_FALSE);
+
+        // decides whether the given length is a power of two
+        static GLboolean IsPowerOfTwo(GLuint n);
+
+    private:
+        // unnormalized radix-2 transform, the length has to be a power of two
+        static GLvoid _Radix2(std::vector<Complex>& x, GLboolean inverse);
+
+        // unnormalized forward transform of arbitrary length
+        static GLvoid _Bluestein(std::vector<Complex>& x);
+    };
+}
@@ -57,6 +57,33 @@ GenericCurve3& GenericCurve3::operator =(const GenericCurve3& rhs)
     return *this;
 }
 
+// move constructor
+GenericCurve3::GenericCurve3(GenericCurve3&& curve) noexcept:
+        _usage_flag(curve._usage_flag),
+        _vbo_derivative(RowMatrix<GLuint>(curve._vbo_derivative.GetColumnCount())),
+        _derivative(std::move(curve._derivative))
+{
+    std::swap(_vbo_derivative, curve._vbo_derivative);
+    curve._derivative.ResizeRows(_derivative.GetRowCount());
+}
+
+// move assignment operator
+GenericCurve3& GenericCurve3::operator =(GenericCurve3&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        DeleteVertexBufferObjects();
+
+        _usage_flag = rhs._usage_flag;
+        _vbo_derivative = std::move(rhs._vbo_derivative);
+        _derivative = std::move(rhs._derivative);
+
+        rhs._vbo_derivative.ResizeColumns(_vbo_derivative.GetColumnCount());
+        rhs._derivative.ResizeRows(_derivative.GetRowCount());
+    }
+    return *this;
+}
+
 // vertex buffer object handling methods
 GLvoid GenericCurve3::DeleteVertexBufferObjects()
 {
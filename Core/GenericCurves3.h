@@ -41,6 +41,12 @@ namespace cagd
         // assignment operator
         GenericCurve3& operator =(const GenericCurve3& rhs);
 
+        // move constructor and move assignment operator: the derivatives and the vertex buffer
+        // objects are taken over without any copy or OpenGL call, the source keeps its maximum
+        // order of derivatives but has no points
+        GenericCurve3(GenericCurve3&& curve) noexcept;
+        GenericCurve3& operator =(GenericCurve3&& rhs) noexcept;
+
         // vertex buffer object handling methods
         GLvoid DeleteVertexBufferObjects();
         GLboolean RenderDerivatives(GLuint order, GLenum render_mode) const;
@@ -0,0 +1,52 @@
+#include "InterpolationPlanCache.h"
+
+using namespace std;
+
+using namespace cagd;
+
+mutex InterpolationPlanCache::_mutex;
+map<InterpolationPlanCache::Key, InterpolationPlanCache::Plan> InterpolationPlanCache::_plans;
+
+InterpolationPlanCache::Plan InterpolationPlanCache::Find(const Key& key)
+{
+    lock_guard<mutex> lock(_mutex);
+
+    auto it = _plans.find(key);
+    if (it != _plans.end())
+    {
+        return it->second;
+    }
+
+    return Plan();
+}
+
+InterpolationPlanCache::Plan InterpolationPlanCache::Insert(const Key& key, RealSquareMatrix&& collocation_matrix)
+{
+    if (!collocation_matrix.IsLUDecompositionDone())
+    {
+        return Plan();
+    }
+
+    // the plan is created outside of the critical section
+    Plan plan = make_shared<const RealSquareMatrix>(std::move(collocation_matrix));
+
+    lock_guard<mutex> lock(_mutex);
+    if (_plans.size() >= _maximum_plan_count)
+    {
+        _plans.clear();
+    }
+
+    return _plans.insert(make_pair(key, plan)).first->second;
+}
+
+GLvoid InterpolationPlanCache::Clear()
+{
+    lock_guard<mutex> lock(_mutex);
+    _plans.clear();
+}
+
+GLuint InterpolationPlanCache::GetPlanCount()
+{
+    lock_guard<mutex> lock(_mutex);
+    return (GLuint)_plans.size();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "RealSquareMatrices.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cagd
+{
+    // process-wide, thread-safe cache of interpolation plans, i.e., of LU decomposed collocation
+    // matrices; curves and surfaces that use the same blending functions at the same knots share
+    // a single plan, thus re-interpolating new data points costs only the triangular solves
+    class InterpolationPlanCache
+    {
+    public:
+        // shared, read-only collocation matrix whose LU decomposition has already been performed
+        typedef std::shared_ptr<const RealSquareMatrix> Plan;
+
+        // key: (identifier of the blending function system, e.g., its type name and direction,
+        //       shape parameters of the blending functions followed by the knot vector)
+        typedef std::pair<std::string, std::vector<GLdouble> > Key;
+
+        // returns the plan of the given key, or an empty pointer if it is not cached
+        static Plan Find(const Key& key);
+
+        // stores the given LU decomposed collocation matrix and returns the cached plan of the key
+        // (if another thread has inserted the same key in the meantime, its plan is returned)
+        static Plan Insert(const Key& key, RealSquareMatrix&& collocation_matrix);
+
+        // releases every cached plan
+        static GLvoid Clear();
+
+        // number of cached plans
+        static GLuint GetPlanCount();
+
+    private:
+        // at most this many plans are kept, the whole cache is cleared when it overflows
+        static const GLuint _maximum_plan_count = 64;
+
+        static std::mutex          _mutex;
+        static std::map<Key, Plan> _plans;
+    };
+}
@@ -1,5 +1,9 @@
 #include "LinearCombination3.h"
 #include "RealSquareMatrices.h"
+#include "InterpolationPlanCache.h"
+#include "Parallelism.h"
+#include <algorithm>
+#include <typeinfo>
 
 using namespace cagd;
 using namespace std;
@@ -27,11 +31,7 @@ LinearCombination3::Derivatives& LinearCombination3::Derivatives::operator =(con
 // set every derivative to null vector
 GLvoid LinearCombination3::Derivatives::LoadNullVectors()
 {
-    for (GLuint i = 0; i < _data.size(); ++i)
-    {
-        for (GLuint j = 0; j < 3; ++j)
-            _data[i][0][j] = 0.0;
-    }
+    std::fill(_data.begin(), _data.end(), DCoordinate3());
 }
 
 // special constructor
@@ -73,6 +73,35 @@ LinearCombination3& LinearCombination3::operator =(const LinearCombination3& rhs
     return *this;
 }
 
+// move constructor
+LinearCombination3::LinearCombination3(LinearCombination3&& lc) noexcept:
+        _vbo_data(lc._vbo_data),
+        _data_usage_flag(lc._data_usage_flag),
+        _u_min(lc._u_min), _u_max(lc._u_max),
+        _data(std::move(lc._data))
+{
+    lc._vbo_data = 0;
+}
+
+// move assignment operator
+LinearCombination3& LinearCombination3::operator =(LinearCombination3&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        DeleteVertexBufferObjectsOfData();
+
+        _vbo_data = rhs._vbo_data;
+        _data_usage_flag = rhs._data_usage_flag;
+        _u_min = rhs._u_min;
+        _u_max = rhs._u_max;
+        _data = std::move(rhs._data);
+
+        rhs._vbo_data = 0;
+    }
+
+    return *this;
+}
+
 // vbo handling methods
 GLvoid LinearCombination3::DeleteVertexBufferObjectsOfData()
 {
@@ -167,7 +196,19 @@ DCoordinate3& LinearCombination3::operator [](GLuint index)
 
 
 
+// the default batch-basis hook is not implemented
+GLboolean LinearCombination3::BlendingFunctionTable(const GLdouble* u, GLuint count, GLuint max_order_of_derivatives, SharedTable& table) const
+{
+    (void)u, (void)count, (void)max_order_of_derivatives, (void)table;
+    return GL_FALSE;
+}
+
 // assure interpolation
+GLboolean LinearCombination3::InterpolationSignature(std::vector<GLdouble>&) const
+{
+    return GL_FALSE;
+}
+
 GLboolean LinearCombination3::UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate)
 {
     GLuint data_count = _data.GetRowCount();
@@ -176,6 +217,21 @@ GLboolean LinearCombination3::UpdateDataForInterpolation(const ColumnMatrix<GLdo
         data_count != data_points_to_interpolate.GetRowCount())
         return GL_FALSE;
 
+    // if the blending functions can be identified, the LU decomposed collocation matrix is looked
+    // up in the plan cache, thus only the triangular solves remain
+    InterpolationPlanCache::Key key;
+    GLboolean plan_is_shareable = InterpolationSignature(key.second);
+
+    if (plan_is_shareable)
+    {
+        key.first = typeid(*this).name();
+        key.second.insert(key.second.end(), knot_vector.GetData(), knot_vector.GetData() + data_count);
+
+        InterpolationPlanCache::Plan plan = InterpolationPlanCache::Find(key);
+        if (plan)
+            return plan->SolveLinearSystem(data_points_to_interpolate, _data);
+    }
+
     RealSquareMatrix collocation_matrix(data_count);
 
     RowMatrix<GLdouble> current_blending_function_values(data_count);
@@ -187,6 +243,15 @@ GLboolean LinearCombination3::UpdateDataForInterpolation(const ColumnMatrix<GLdo
             collocation_matrix.SetRow(r, current_blending_function_values);
     }
 
+    if (!collocation_matrix.PerformLUDecomposition())
+        return GL_FALSE;
+
+    if (plan_is_shareable)
+    {
+        InterpolationPlanCache::Plan plan = InterpolationPlanCache::Insert(key, std::move(collocation_matrix));
+        return plan && plan->SolveLinearSystem(data_points_to_interpolate, _data);
+    }
+
     return collocation_matrix.SolveLinearSystem(data_points_to_interpolate, _data);
 }
 
@@ -213,24 +278,56 @@ GenericCurve3* LinearCombination3::GenerateImage(GLuint max_order_of_derivatives
         return 0;
 
 
-    Derivatives d;
-    // set derivatives at the endpoints of the parametric curve
-    CalculateDerivatives(max_order_of_derivatives, _u_min, d);
-    (*result)._derivative.SetColumn(0, d);
+    // uniform subdivision of the definition domain
+    GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
 
-    CalculateDerivatives(max_order_of_derivatives, _u_max, d);
-    (*result)._derivative.SetColumn(div_point_count - 1, d);
+    RowMatrix<GLdouble> u_parameters(div_point_count);
+    for (GLuint i = 0; i < div_point_count; ++i)
+        u_parameters[i] = min(_u_min + i * u_step, _u_max);
 
+    // if the blending function table is available, every derivative is a linear combination of
+    // the control points with the tabulated weights
+    GLuint data_count = _data.GetRowCount();
 
-    // calculate derivatives at inner curve points
-    GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
-    GLdouble u = _u_min - u_step;
-    for (GLuint i = 1; i < div_point_count - 1; ++i)
+    // the samples are distributed among the tessellation threads, the output layout does not
+    // depend on their number
+    [[maybe_unused]] GLint thread_count = TessellationThreadCount(div_point_count);
+
+    SharedTable shared_table;
+    if (BlendingFunctionTable(u_parameters.GetData(), div_point_count, max_order_of_derivatives, shared_table))
     {
-        u += u_step;
-        CalculateDerivatives(max_order_of_derivatives, u, d);
-        (*result)._derivative.SetColumn(i, d);
+        const Matrix<GLdouble> &table = *shared_table;
+
+        #pragma omp parallel for num_threads(thread_count) if(thread_count > 1) schedule(static)
+        for (GLint i = 0; i < (GLint)div_point_count; ++i)
+        {
+            for (GLuint r = 0; r <= max_order_of_derivatives; ++r)
+            {
+                DCoordinate3 &derivative = (*result)._derivative(r, i);
+                for (GLuint k = 0; k < data_count; ++k)
+                    derivative += _data[k] * table(r * data_count + k, i);
+            }
+        }
+
+        return result;
     }
+
+    // otherwise every thread reuses its own derivatives for all of its samples
+    #pragma omp parallel num_threads(thread_count) if(thread_count > 1)
+    {
+        Derivatives d(max_order_of_derivatives);
+
+        // the first sample may resize the derivatives
+        CalculateDerivatives(max_order_of_derivatives, u_parameters[0], d);
+
+        #pragma omp for schedule(static)
+        for (GLint i = 0; i < (GLint)div_point_count; ++i)
+        {
+            CalculateDerivatives(max_order_of_derivatives, u_parameters[i], d);
+            (*result)._derivative.SetColumn(i, d);
+        }
+    }
+
     return result;
 }
 
@@ -3,6 +3,8 @@
 #include "DCoordinates3.h"
 #include "GenericCurves3.h"
 #include "Matrices.h"
+#include <memory>
+#include <vector>
 
 namespace cagd
 {
@@ -12,6 +14,9 @@ namespace cagd
     class LinearCombination3
     {
     public:
+        // read-only blending function table of the batch-basis hook, it may be shared by a cache
+        typedef std::shared_ptr<const Matrix<GLdouble> > SharedTable;
+
         class Derivatives: public ColumnMatrix<DCoordinate3>
         {
         public:
@@ -47,6 +52,11 @@ namespace cagd
         // assignment operator
         LinearCombination3& operator =(const LinearCombination3& rhs);
 
+        // move constructor and move assignment operator: the data points and their vertex buffer
+        // object are taken over without any copy or OpenGL call, the source has no data points
+        LinearCombination3(LinearCombination3&& lc) noexcept;
+        LinearCombination3& operator =(LinearCombination3&& rhs) noexcept;
+
         // vbo handling methods
         virtual GLvoid DeleteVertexBufferObjectsOfData();
         virtual GLboolean RenderData(GLenum render_mode = GL_LINE_STRIP) const;
@@ -68,6 +78,12 @@ namespace cagd
         // calculates a row matrix which consists of function values {F_i(u)}_{i=0}^{data_count-1}
         virtual GLboolean BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble>& values) const = 0;
 
+        // batch-basis hook of the image generation: for the given array of parameter values the row
+        // r * data_count + i of the table has to store the r-th order derivative of F_i at every
+        // parameter value, where r = 0, 1,..., max_order_of_derivatives; the default implementation
+        // returns GL_FALSE, i.e., the image is generated point by point
+        virtual GLboolean BlendingFunctionTable(const GLdouble* u, GLuint count, GLuint max_order_of_derivatives, SharedTable& table) const;
+
         //----------------
         // abstract method
         //----------------
@@ -75,6 +91,14 @@ namespace cagd
         // combination sum_{i=0}^{data_count -1} _data[i] F_i(u) at the parameter value u
         virtual GLboolean CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives& d) const = 0;
 
+        // interpolation-plan hook: appends the shape parameters that (together with the dynamic type
+        // of the object and the data count) determine the blending functions, e.g., the order of a
+        // cyclic curve or the alpha of a SOQAH arc; the LU decomposed collocation matrices of
+        // objects with identical signatures and knot vectors are shared through the
+        // InterpolationPlanCache; the default implementation returns GL_FALSE, i.e., the
+        // collocation matrix is always rebuilt
+        virtual GLboolean InterpolationSignature(std::vector<GLdouble>& signature) const;
+
         // generate image/arc
         virtual GenericCurve3* GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
 
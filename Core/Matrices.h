@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <utility>
 #include <vector>
 #include <GL/glew.h>
 
@@ -36,9 +38,63 @@ namespace cagd
     template <typename T>
     std::ostream& operator << (std::ostream& lhs, const TriangularMatrix<T>& rhs);
 
+    //------------------------------------
+    // matrix storage allocation statistics
+    //------------------------------------
+    // debug builds count how many times the calling thread has (re)allocated the element
+    // storage of a Matrix (or of a derived class) or of a TriangularMatrix; other heap
+    // allocations (e.g., of std::vector or std::string members) are not counted, thus the
+    // counter only proves that a loop does not resize matrices; release builds do not track
+    // anything and always report 0
+    inline GLulong& MatrixStorageAllocationCount()
+    {
+        static thread_local GLulong count = 0;
+        return count;
+    }
+
+    template <typename T>
+    inline GLvoid _CountMatrixStorageAllocation(const std::vector<T>& data, std::size_t previous_capacity)
+    {
+#ifndef NDEBUG
+        if (data.capacity() != previous_capacity)
+            ++MatrixStorageAllocationCount();
+#else
+        (void)data;
+        (void)previous_capacity;
+#endif
+    }
+
+    //--------------------------
+    // template class MatrixSpan
+    //--------------------------
+    // a non-owning view of consecutive elements that are stored at a fixed stride
+    // (rows of a matrix have stride 1, while columns have the stride column_count)
+    template <typename T>
+    class MatrixSpan
+    {
+    protected:
+        T*      _pointer;
+        GLuint  _count;
+        GLuint  _stride;
+
+    public:
+        // special constructor (can also be used as a default constructor)
+        MatrixSpan(T* pointer = nullptr, GLuint count = 0, GLuint stride = 1);
+
+        // get element by reference (unchecked in release builds)
+        T& operator [](GLuint index) const;
+
+        // get properties
+        T*     GetPointer() const;
+        GLuint GetCount() const;
+        GLuint GetStride() const;
+    };
+
     //----------------------
     // template class Matrix
     //----------------------
+    // elements are stored in a single row-major buffer, i.e., the element (r, c)
+    // is located at the position r * _column_count + c of the vector _data
     template <typename T>
     class Matrix
     {
@@ -46,9 +102,9 @@ namespace cagd
         friend std::istream& cagd::operator >> <T>(std::istream&, Matrix<T>& rhs);
 
     protected:
-        GLuint                          _row_count;
-        GLuint                          _column_count;
-        std::vector< std::vector<T> >   _data;
+        GLuint          _row_count;
+        GLuint          _column_count;
+        std::vector<T>  _data;
     public:
         // special constructor (can also be used as a default constructor)
         Matrix(GLuint row_count = 1, GLuint column_count = 1);
@@ -59,16 +115,32 @@ namespace cagd
         // assignment operator
         Matrix& operator =(const Matrix& m);
 
-        // get element by reference
+        // move constructor and move assignment operator: the storage is stolen, the source
+        // becomes a 0 x 0 matrix
+        Matrix(Matrix&& m) noexcept;
+        Matrix& operator =(Matrix&& m) noexcept;
+
+        // get element by reference (bounds are checked only by debug builds)
         T& operator ()(GLuint row, GLuint column);
 
-        // get copy of an element
+        // get copy of an element (bounds are checked only by debug builds)
         T operator ()(GLuint row, GLuint column) const;
 
         // get dimensions
         GLuint GetRowCount() const;
         GLuint GetColumnCount() const;
 
+        // direct access to the contiguous row-major storage
+        T* GetData();
+        const T* GetData() const;
+
+        // non-owning views of a row or of a (strided) column
+        MatrixSpan<T> GetRowSpan(GLuint row);
+        MatrixSpan<const T> GetRowSpan(GLuint row) const;
+
+        MatrixSpan<T> GetColumnSpan(GLuint column);
+        MatrixSpan<const T> GetColumnSpan(GLuint column) const;
+
         // set dimensions
         virtual GLboolean ResizeRows(GLuint row_count);
         virtual GLboolean ResizeColumns(GLuint column_count);
@@ -91,6 +163,12 @@ namespace cagd
         // special constructor (can also be used as a default constructor)
         RowMatrix(GLuint column_count = 1);
 
+        // copy and move semantics, a moved-from row matrix has a single empty row
+        RowMatrix(const RowMatrix& m) = default;
+        RowMatrix(RowMatrix&& m) noexcept;
+        RowMatrix& operator =(const RowMatrix& m) = default;
+        RowMatrix& operator =(RowMatrix&& m) noexcept;
+
         // get element by reference
         T& operator ()(GLuint column);
         T& operator [](GLuint column);
@@ -113,6 +191,12 @@ namespace cagd
         // special constructor (can also be used as a default constructor)
         ColumnMatrix(GLuint row_count = 1);
 
+        // copy and move semantics, a moved-from column matrix has a single empty column
+        ColumnMatrix(const ColumnMatrix& m) = default;
+        ColumnMatrix(ColumnMatrix&& m) noexcept;
+        ColumnMatrix& operator =(const ColumnMatrix& m) = default;
+        ColumnMatrix& operator =(ColumnMatrix&& m) noexcept;
+
         // get element by reference
         T& operator ()(GLuint row);
         T& operator [](GLuint row);
@@ -128,6 +212,8 @@ namespace cagd
 	//--------------------------------
     // template class TriangularMatrix
     //--------------------------------
+    // the lower triangular part is packed row by row into a single vector, i.e., the
+    // element (r, c) with c <= r is located at the position r * (r + 1) / 2 + c
     template <typename T>
     class TriangularMatrix
     {
@@ -135,26 +221,83 @@ namespace cagd
         friend std::ostream& cagd::operator << <T>(std::ostream&, const TriangularMatrix<T>& rhs);
 
     protected:
-        GLuint                        _row_count;
-        std::vector< std::vector<T> > _data;
+        GLuint          _row_count;
+        std::vector<T>  _data;
 
     public:
         // special constructor (can also be used as a default constructor)
         TriangularMatrix(GLuint row_count = 1);
 
-        // get element by reference
+        // copy and move semantics, a moved-from triangular matrix has no rows
+        TriangularMatrix(const TriangularMatrix& m) = default;
+        TriangularMatrix(TriangularMatrix&& m) noexcept;
+        TriangularMatrix& operator =(const TriangularMatrix& m) = default;
+        TriangularMatrix& operator =(TriangularMatrix&& m) noexcept;
+
+        // get element by reference (bounds are checked only by debug builds)
         T& operator ()(GLuint row, GLuint column);
 
-        // get copy of an element
+        // get copy of an element (bounds are checked only by debug builds)
         T operator ()(GLuint row, GLuint column) const;
 
         // get dimension
         GLuint GetRowCount() const;
 
-        // set dimension
+        // direct access to the packed storage
+        T* GetData();
+        const T* GetData() const;
+
+        // set dimension (shrinking, or growing within the already reserved capacity,
+        // does not reallocate)
         GLboolean ResizeRows(GLuint row_count);
+
+        // reserves storage for the given number of rows without changing the dimension
+        GLvoid Reserve(GLuint row_count);
+
+        // overwrites every element without reallocating the storage
+        GLvoid Fill(const T& value);
     };
 
+    //--------------------------------------------
+    // implementation of template class MatrixSpan
+    //--------------------------------------------
+
+    // Constructor
+    template <typename T>
+    MatrixSpan<T>::MatrixSpan(T* pointer, GLuint count, GLuint stride)
+        : _pointer(pointer)
+        , _count(count)
+        , _stride(stride)
+    {
+    }
+
+    // Get element by reference
+    template <typename T>
+    inline T& MatrixSpan<T>::operator [](GLuint index) const
+    {
+        assert(index < _count);
+        return _pointer[index * _stride];
+    }
+
+    // Get properties
+    template <typename T>
+    inline T* MatrixSpan<T>::GetPointer() const
+    {
+        return _pointer;
+    }
+
+    template <typename T>
+    inline GLuint MatrixSpan<T>::GetCount() const
+    {
+        return _count;
+    }
+
+    template <typename T>
+    inline GLuint MatrixSpan<T>::GetStride() const
+    {
+        return _stride;
+    }
+
     //--------------------------------------------------
     // homework: implementation of template class Matrix
     //--------------------------------------------------
@@ -164,8 +307,9 @@ namespace cagd
     Matrix<T>::Matrix(GLuint row_count, GLuint column_count)
         : _row_count(row_count)
         , _column_count(column_count)
-        , _data(_row_count, std::vector<T>(_column_count))
+        , _data(row_count * column_count)
     {
+        _CountMatrixStorageAllocation(_data, 0);
     }
 
     // Copy Constructor
@@ -175,6 +319,7 @@ namespace cagd
         , _column_count(m._column_count)
         , _data(m._data)
     {
+        _CountMatrixStorageAllocation(_data, 0);
     }
 
     // Assignment Operator
@@ -183,9 +328,42 @@ namespace cagd
     {
         if (this != &m)
         {
+            std::size_t capacity = _data.capacity();
+
             _row_count = m._row_count;
             _column_count = m._column_count;
             _data = m._data;
+
+            _CountMatrixStorageAllocation(_data, capacity);
+        }
+        return *this;
+    }
+
+    // Move Constructor
+    template <typename T>
+    Matrix<T>::Matrix(Matrix<T>&& m) noexcept
+        : _row_count(m._row_count)
+        , _column_count(m._column_count)
+        , _data(std::move(m._data))
+    {
+        m._row_count = 0;
+        m._column_count = 0;
+        m._data.clear();
+    }
+
+    // Move Assignment Operator
+    template <typename T>
+    inline Matrix<T>& Matrix<T>::operator =(Matrix&& m) noexcept
+    {
+        if (this != &m)
+        {
+            _row_count = m._row_count;
+            _column_count = m._column_count;
+            _data.swap(m._data);
+
+            m._row_count = 0;
+            m._column_count = 0;
+            m._data.clear();
         }
         return *this;
     }
@@ -194,14 +372,16 @@ namespace cagd
     template <typename T>
     inline T& Matrix<T>::operator ()(GLuint row, GLuint column)
     {
-        return _data.at(row).at(column); //_data[row][column];
+        assert(row < _row_count && column < _column_count);
+        return _data[row * _column_count + column];
     }
 
     // Get copy of element (simple getter)
     template <typename T>
     inline T Matrix<T>::operator ()(GLuint row, GLuint column) const
     {
-        return _data.at(row).at(column); //_data[row][column];
+        assert(row < _row_count && column < _column_count);
+        return _data[row * _column_count + column];
     }
 
     // Get dimensions
@@ -220,29 +400,87 @@ namespace cagd
         return _column_count;
     }
 
+    // Direct access to the storage
+
+    template <typename T>
+    inline T* Matrix<T>::GetData()
+    {
+        return _data.data();
+    }
+
+    template <typename T>
+    inline const T* Matrix<T>::GetData() const
+    {
+        return _data.data();
+    }
+
+    // Row and column views
+
+    template <typename T>
+    inline MatrixSpan<T> Matrix<T>::GetRowSpan(GLuint row)
+    {
+        assert(row < _row_count);
+        return MatrixSpan<T>(_data.data() + row * _column_count, _column_count, 1);
+    }
+
+    template <typename T>
+    inline MatrixSpan<const T> Matrix<T>::GetRowSpan(GLuint row) const
+    {
+        assert(row < _row_count);
+        return MatrixSpan<const T>(_data.data() + row * _column_count, _column_count, 1);
+    }
+
+    template <typename T>
+    inline MatrixSpan<T> Matrix<T>::GetColumnSpan(GLuint column)
+    {
+        assert(column < _column_count);
+        return MatrixSpan<T>(_data.data() + column, _row_count, _column_count);
+    }
+
+    template <typename T>
+    inline MatrixSpan<const T> Matrix<T>::GetColumnSpan(GLuint column) const
+    {
+        assert(column < _column_count);
+        return MatrixSpan<const T>(_data.data() + column, _row_count, _column_count);
+    }
+
     // Set dimensions
 
+    // rows are stored one after the other, therefore a simple resize preserves the
+    // existing elements
     template <typename T>
     inline GLboolean Matrix<T>::ResizeRows(GLuint row_count)
     {
-        _data.resize(row_count);
-        for (GLuint i = 0; i < row_count; i++)
-        {
-            _data[i].resize(_column_count);
-        }
+        std::size_t capacity = _data.capacity();
+        _data.resize(row_count * _column_count);
+        _CountMatrixStorageAllocation(_data, capacity);
         _row_count = row_count;
         return GL_TRUE;
     }
 
+    // changing the column count alters the row stride, so the common elements have
+    // to be relocated
     template <typename T>
     inline GLboolean Matrix<T>::ResizeColumns(GLuint column_count)
     {
-        _column_count = column_count;
+        if (column_count == _column_count)
+        {
+            return GL_TRUE;
+        }
+
+        std::vector<T> data(_row_count * column_count);
+        _CountMatrixStorageAllocation(data, 0);
 
+        GLuint common_column_count = std::min(_column_count, column_count);
         for (GLuint i = 0; i < _row_count; i++)
         {
-            _data.at(i).resize(_column_count);
+            std::copy(_data.begin() + i * _column_count,
+                      _data.begin() + i * _column_count + common_column_count,
+                      data.begin() + i * column_count);
         }
+
+        _data.swap(data);
+        _column_count = column_count;
         return GL_TRUE;
     }
 
@@ -256,7 +494,7 @@ namespace cagd
             return GL_FALSE;
         }
 
-        _data[index] = row._data[0];
+        std::copy(row._data.begin(), row._data.end(), _data.begin() + index * _column_count);
 
         return GL_TRUE;
     }
@@ -271,7 +509,7 @@ namespace cagd
 
         for (GLuint i = 0; i < _row_count; i++)
         {
-            _data[i][index] = column[i];
+            _data[i * _column_count + index] = column._data[i];
         }
 
         return GL_TRUE;
@@ -281,10 +519,6 @@ namespace cagd
     template <typename T>
     Matrix<T>::~Matrix()
     {
-        for(GLuint i = 0; i < _row_count; i++)
-        {
-            _data[i].clear();
-        }
         _data.clear();
 
         _row_count = _column_count = 0;
@@ -301,30 +535,52 @@ namespace cagd
     {
     }
 
+    // Move Constructor
+    template <typename T>
+    RowMatrix<T>::RowMatrix(RowMatrix<T>&& m) noexcept
+        : Matrix<T>(std::move(m))
+    {
+        m._row_count = 1;
+    }
+
+    // Move Assignment Operator
+    template <typename T>
+    inline RowMatrix<T>& RowMatrix<T>::operator =(RowMatrix<T>&& m) noexcept
+    {
+        Matrix<T>::operator =(std::move(m));
+        m._row_count = 1;
+        this->_row_count = 1;
+        return *this;
+    }
+
     // Get element by reference
     template <typename T>
     inline T& RowMatrix<T>::operator ()(GLuint column)
     {
-        return this->_data[0][column];
+        assert(column < this->_column_count);
+        return this->_data[column];
     }
 
     template <typename T>
     inline T& RowMatrix<T>::operator [](GLuint column)
     {
-        return this->_data[0][column];
+        assert(column < this->_column_count);
+        return this->_data[column];
     }
 
     // Get copy of an element
     template <typename T>
     inline T RowMatrix<T>::operator ()(GLuint column) const
     {
-        return this->_data[0][column];
+        assert(column < this->_column_count);
+        return this->_data[column];
     }
 
     template <typename T>
     inline T RowMatrix<T>::operator [](GLuint column) const
     {
-        return this->_data[0][column];
+        assert(column < this->_column_count);
+        return this->_data[column];
     }
 
     // RowMatirx is made of a single row
@@ -351,30 +607,52 @@ namespace cagd
     {
     }
 
+    // Move Constructor
+    template <typename T>
+    ColumnMatrix<T>::ColumnMatrix(ColumnMatrix<T>&& m) noexcept
+        : Matrix<T>(std::move(m))
+    {
+        m._column_count = 1;
+    }
+
+    // Move Assignment Operator
+    template <typename T>
+    inline ColumnMatrix<T>& ColumnMatrix<T>::operator =(ColumnMatrix<T>&& m) noexcept
+    {
+        Matrix<T>::operator =(std::move(m));
+        m._column_count = 1;
+        this->_column_count = 1;
+        return *this;
+    }
+
     // Get element by reference
     template <typename T>
     inline T& ColumnMatrix<T>::operator ()(GLuint row)
     {
-        return this->_data[row][0];
+        assert(row < this->_row_count);
+        return this->_data[row];
     }
 
     template <typename T>
     inline T& ColumnMatrix<T>::operator [](GLuint row)
     {
-        return this->_data[row][0];
+        assert(row < this->_row_count);
+        return this->_data[row];
     }
 
     // Get element by value
     template <typename T>
     inline T ColumnMatrix<T>::operator ()(GLuint row) const
     {
-        return this->_data[row][0];
+        assert(row < this->_row_count);
+        return this->_data[row];
     }
 
     template <typename T>
     inline T ColumnMatrix<T>::operator [](GLuint row) const
     {
-        return this->_data[row][0];
+        assert(row < this->_row_count);
+        return this->_data[row];
     }
 
     // ColumnMatrix is made of a single column
@@ -398,14 +676,34 @@ namespace cagd
     template <typename T>
     TriangularMatrix<T>::TriangularMatrix(GLuint row_count)
         : _row_count(row_count)
+        , _data(row_count * (row_count + 1) / 2)
     {
-        GLuint column_count = 1;
-        _data.resize(_row_count);
-        for (GLuint i = 0; i < _row_count; i++)
+        _CountMatrixStorageAllocation(_data, 0);
+    }
+
+    // Move Constructor
+    template <typename T>
+    TriangularMatrix<T>::TriangularMatrix(TriangularMatrix<T>&& m) noexcept
+        : _row_count(m._row_count)
+        , _data(std::move(m._data))
+    {
+        m._row_count = 0;
+        m._data.clear();
+    }
+
+    // Move Assignment Operator
+    template <typename T>
+    inline TriangularMatrix<T>& TriangularMatrix<T>::operator =(TriangularMatrix<T>&& m) noexcept
+    {
+        if (this != &m)
         {
-            _data[i].resize(column_count);
-            column_count++;
+            _row_count = m._row_count;
+            _data.swap(m._data);
+
+            m._row_count = 0;
+            m._data.clear();
         }
+        return *this;
     }
 
     // Get element by reference
@@ -413,7 +711,7 @@ namespace cagd
     inline T& TriangularMatrix<T>::operator ()(GLuint row, GLuint column)
     {
         assert(row < _row_count && column <= row);
-        return _data[row][column];
+        return _data[row * (row + 1) / 2 + column];
     }
 
     // Get element by value
@@ -421,7 +719,7 @@ namespace cagd
     inline T TriangularMatrix<T>::operator ()(GLuint row, GLuint column) const
     {
         assert(row < _row_count && column <= row);
-        return _data[row][column];
+        return _data[row * (row + 1) / 2 + column];
     }
 
     // Get dimension
@@ -431,19 +729,49 @@ namespace cagd
         return _row_count;
     }
 
+    // Direct access to the storage
+
+    template <typename T>
+    inline T* TriangularMatrix<T>::GetData()
+    {
+        return _data.data();
+    }
+
+    template <typename T>
+    inline const T* TriangularMatrix<T>::GetData() const
+    {
+        return _data.data();
+    }
+
     // Set dimension
+
+    // rows are packed one after the other, therefore a simple resize preserves the
+    // existing elements
     template <typename T>
     inline GLboolean TriangularMatrix<T>::ResizeRows(GLuint row_count)
     {
-        _data.resize(row_count);
-        for (GLuint i = 0; i < row_count; i++)
-        {
-            _data[i].resize(i + 1);
-        }
+        std::size_t capacity = _data.capacity();
+        _data.resize(row_count * (row_count + 1) / 2);
+        _CountMatrixStorageAllocation(_data, capacity);
         _row_count = row_count;
         return GL_TRUE;
     }
 
+    template <typename T>
+    inline GLvoid TriangularMatrix<T>::Reserve(GLuint row_count)
+    {
+        std::size_t capacity = _data.capacity();
+        _data.reserve(row_count * (row_count + 1) / 2);
+        _CountMatrixStorageAllocation(_data, capacity);
+    }
+
+    // Overwrite every element
+    template <typename T>
+    inline GLvoid TriangularMatrix<T>::Fill(const T& value)
+    {
+        std::fill(_data.begin(), _data.end(), value);
+    }
+
     //------------------------------------------------------------------------------
     // definitions of overloaded and templated input/output from/to stream operators
     //------------------------------------------------------------------------------
@@ -453,12 +781,10 @@ namespace cagd
     std::ostream& operator <<(std::ostream& lhs, const Matrix<T>& rhs)
     {
         lhs << rhs._row_count << " " << rhs._column_count << std::endl;
-        for (typename std::vector< std::vector<T> >::const_iterator row = rhs._data.begin();
-             row != rhs._data.end(); ++row)
+        for (GLuint i = 0; i < rhs._row_count; ++i)
         {
-            for (typename std::vector<T>::const_iterator column = row->begin();
-                 column != row->end(); ++column)
-                    lhs << *column << " ";
+            for (GLuint j = 0; j < rhs._column_count; ++j)
+                    lhs << rhs._data[i * rhs._column_count + j] << " ";
             lhs << std::endl;
         }
         return lhs;
@@ -469,16 +795,10 @@ namespace cagd
     std::istream& operator >>(std::istream& lhs, Matrix<T>& rhs)
     {
         lhs >> rhs._row_count >> rhs._column_count;
-        rhs._data.resize(rhs._row_count);
-        for (auto row = rhs._data.begin();
-             row != rhs._data.end(); ++row)
+        rhs._data.resize(rhs._row_count * rhs._column_count);
+        for (auto element = rhs._data.begin(); element != rhs._data.end(); ++element)
         {
-            row->resize(rhs._column_count);
-            for (auto column = row->begin();
-                 column != row->end(); ++column)
-            {
-                    lhs >> *column;
-            }
+            lhs >> *element;
         }
         return lhs;
     }
@@ -486,13 +806,11 @@ namespace cagd
     template <typename T>
     std::ostream& operator <<(std::ostream& lhs, const TriangularMatrix<T>& rhs)
     {
-        lhs << rhs._row_count << " " << rhs._column_count << std::endl;
-        for (typename std::vector< std::vector<T> >::const_iterator row = rhs._data.begin();
-             row != rhs._data.end(); ++row)
+        lhs << rhs._row_count << std::endl;
+        for (GLuint i = 0; i < rhs._row_count; ++i)
         {
-            for (typename std::vector<T>::const_iterator column = row->begin();
-                 column != row->end(); ++column)
-                    lhs << *column << " ";
+            for (GLuint j = 0; j <= i; ++j)
+                    lhs << rhs._data[i * (i + 1) / 2 + j] << " ";
             lhs << std::endl;
         }
         return lhs;
@@ -502,18 +820,11 @@ namespace cagd
     template <typename T>
     std::istream& operator >>(std::istream& lhs, TriangularMatrix<T>& rhs)
     {
-        lhs >> rhs._row_count >> rhs._column_count;
-        rhs._data.resize(rhs._row_count);
-        GLuint column_count = 1;
-        for (auto row = rhs._data.begin();
-             row != rhs._data.end(); ++row, ++column_count)
+        lhs >> rhs._row_count;
+        rhs._data.resize(rhs._row_count * (rhs._row_count + 1) / 2);
+        for (auto element = rhs._data.begin(); element != rhs._data.end(); ++element)
         {
-            row->resize(column_count);
-            for (auto column = row->begin();
-                 column != row->end(); ++column)
-            {
-                    lhs >> *column;
-            }
+            lhs >> *element;
         }
         return lhs;
     }
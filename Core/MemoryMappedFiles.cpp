@@ -0,0 +1,142 @@
+#include "MemoryMappedFiles.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace cagd;
+using namespace std;
+
+MemoryMappedFile::MemoryMappedFile():
+        _data(nullptr), _size(0), _is_open(GL_FALSE)
+#ifdef _WIN32
+        , _file(INVALID_HANDLE_VALUE), _mapping(nullptr)
+#endif
+{
+}
+
+GLboolean MemoryMappedFile::Open(const string& file_name)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return GL_FALSE;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return GL_FALSE;
+    }
+
+    _file = file;
+    _size = (size_t)size.QuadPart;
+    _is_open = GL_TRUE;
+
+    // files of size 0 cannot be mapped
+    if (!_size)
+        return GL_TRUE;
+
+    _mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_mapping)
+    {
+        Close();
+        return GL_FALSE;
+    }
+
+    _data = (const char*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!_data)
+    {
+        Close();
+        return GL_FALSE;
+    }
+#else
+    int file = open(file_name.c_str(), O_RDONLY);
+    if (file < 0)
+        return GL_FALSE;
+
+    struct stat status;
+    if (fstat(file, &status) < 0 || !S_ISREG(status.st_mode))
+    {
+        close(file);
+        return GL_FALSE;
+    }
+
+    _size = (size_t)status.st_size;
+    _is_open = GL_TRUE;
+
+    // files of size 0 cannot be mapped
+    if (_size)
+    {
+        void *data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED)
+        {
+            close(file);
+            Close();
+            return GL_FALSE;
+        }
+
+        // the file is parsed from front to back
+        madvise(data, _size, MADV_SEQUENTIAL);
+        _data = (const char*)data;
+    }
+
+    // the mapping remains valid after the descriptor is closed
+    close(file);
+#endif
+
+    return GL_TRUE;
+}
+
+GLvoid MemoryMappedFile::Close()
+{
+#ifdef _WIN32
+    if (_data)
+        UnmapViewOfFile(_data);
+    if (_mapping)
+        CloseHandle(_mapping);
+    if (_file != INVALID_HANDLE_VALUE)
+        CloseHandle(_file);
+
+    _mapping = nullptr;
+    _file = INVALID_HANDLE_VALUE;
+#else
+    if (_data)
+        munmap((void*)_data, _size);
+#endif
+
+    _data = nullptr;
+    _size = 0;
+    _is_open = GL_FALSE;
+}
+
+GLboolean MemoryMappedFile::IsOpen() const
+{
+    return _is_open;
+}
+
+const char* MemoryMappedFile::GetData() const
+{
+    return _data;
+}
+
+size_t MemoryMappedFile::GetSize() const
+{
+    return _size;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
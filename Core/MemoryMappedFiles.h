@@ -0,0 +1,46 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <string>
+
+namespace cagd
+{
+    // read-only view of a whole file that is mapped into the address space of the process, thus the
+    // file is read by the page cache on demand, without any intermediate buffer or stream overhead
+    class MemoryMappedFile
+    {
+    public:
+        // default constructor, the file is mapped by the method Open
+        MemoryMappedFile();
+
+        // the mapping is owned by a single instance
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator =(const MemoryMappedFile&) = delete;
+
+        // maps the given file, a previously mapped file is released; fails if the file cannot be
+        // opened, while an empty file is mapped successfully as a buffer of size 0
+        GLboolean Open(const std::string& file_name);
+
+        // releases the mapping
+        GLvoid Close();
+
+        // get properties
+        GLboolean   IsOpen() const;
+        const char* GetData() const;
+        std::size_t GetSize() const;
+
+        // destructor
+        ~MemoryMappedFile();
+
+    private:
+        const char*  _data;
+        std::size_t  _size;
+        GLboolean    _is_open;
+
+#ifdef _WIN32
+        void*        _file;
+        void*        _mapping;
+#endif
+    };
+}
@@ -0,0 +1,299 @@
+#include "MeshExporters.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+using namespace cagd;
+using namespace std;
+
+// the longest formatted record: "3 " followed by three indices of at most 10 digits, or three
+// coordinates of at most 24 characters (in the shortest round-trip form)
+static const size_t MAXIMAL_RECORD_SIZE = 128;
+
+// binary values are stored in little-endian byte order independently of the host
+static inline char* StoreUInt32(char* p, GLuint value)
+{
+    p[0] = (char)(value & 0xff);
+    p[1] = (char)((value >> 8) & 0xff);
+    p[2] = (char)((value >> 16) & 0xff);
+    p[3] = (char)((value >> 24) & 0xff);
+    return p + 4;
+}
+
+static inline char* StoreFloat(char* p, GLfloat value)
+{
+    GLuint bits;
+    memcpy(&bits, &value, sizeof(GLuint));
+    return StoreUInt32(p, bits);
+}
+
+MeshExporter::MeshExporter(Format format, GLuint buffer_size):
+        _format(format),
+        _buffer(max(buffer_size, (GLuint)(4 * MAXIMAL_RECORD_SIZE))),
+        _size(0),
+        _file(nullptr),
+        _is_valid(GL_FALSE)
+{
+}
+
+GLboolean MeshExporter::Export(const string& file_name, const TriangulatedMesh3& mesh)
+{
+    return Export(file_name, vector<const TriangulatedMesh3*>(1, &mesh));
+}
+
+GLboolean MeshExporter::Export(const string& file_name, const vector<const TriangulatedMesh3*>& meshes)
+{
+    GLuint vertex_count = 0, face_count = 0;
+    for (vector<const TriangulatedMesh3*>::const_iterator mit = meshes.begin(); mit != meshes.end(); ++mit)
+    {
+        if (*mit)
+        {
+            vertex_count += (GLuint)(*mit)->_vertex.size();
+            face_count += (GLuint)(*mit)->_face.size();
+        }
+    }
+
+    _file = fopen(file_name.c_str(), "wb");
+    if (!_file)
+        return GL_FALSE;
+
+    // the buffer is written by a single call, thus the file needs no buffer of its own
+    setvbuf(_file, nullptr, _IONBF, 0);
+
+    _size = 0;
+    _is_valid = GL_TRUE;
+
+    switch (_format)
+    {
+    case Format::OFF:
+        _WriteOFF(meshes, vertex_count, face_count);
+        break;
+
+    case Format::PLY:
+        _WritePLY(meshes, vertex_count, face_count);
+        break;
+
+    case Format::STL:
+        _WriteSTL(meshes, face_count);
+        break;
+    }
+
+    _Flush();
+
+    _is_valid = (fclose(_file) == 0) && _is_valid;
+    _file = nullptr;
+
+    return _is_valid;
+}
+
+GLvoid MeshExporter::SetFormat(Format format)
+{
+    _format = format;
+}
+
+MeshExporter::Format MeshExporter::GetFormat() const
+{
+    return _format;
+}
+
+MeshExporter::~MeshExporter()
+{
+    if (_file)
+        fclose(_file);
+}
+
+char* MeshExporter::_Reserve(size_t byte_count)
+{
+    if (_size + byte_count > _buffer.size())
+        _Flush();
+
+    return _buffer.data() + _size;
+}
+
+GLvoid MeshExporter::_Commit(char* end)
+{
+    _size = end - _buffer.data();
+}
+
+GLvoid MeshExporter::_Write(const char* data, size_t byte_count)
+{
+    while (byte_count)
+    {
+        size_t count = min(byte_count, _buffer.size() - _size);
+        memcpy(_buffer.data() + _size, data, count);
+
+        _size += count;
+        data += count;
+        byte_count -= count;
+
+        if (_size == _buffer.size())
+            _Flush();
+    }
+}
+
+GLvoid MeshExporter::_Flush()
+{
+    if (_size && _is_valid)
+        _is_valid = fwrite(_buffer.data(), 1, _size, _file) == _size;
+
+    _size = 0;
+}
+
+GLvoid MeshExporter::_WriteOFF(const vector<const TriangulatedMesh3*>& meshes, GLuint vertex_count, GLuint face_count)
+{
+    string header = "OFF\n" + to_string(vertex_count) + " " + to_string(face_count) + " 0\n";
+    _Write(header.data(), header.size());
+
+    for (vector<const TriangulatedMesh3*>::const_iterator mit = meshes.begin(); mit != meshes.end(); ++mit)
+    {
+        if (!*mit)
+            continue;
+
+        for (vector<DCoordinate3>::const_iterator vit = (*mit)->_vertex.begin(); vit != (*mit)->_vertex.end(); ++vit)
+        {
+            char *p = _Reserve(MAXIMAL_RECORD_SIZE), *end = p + MAXIMAL_RECORD_SIZE;
+
+            for (GLuint component = 0; component < 3; ++component)
+            {
+                p = to_chars(p, end, (*vit)[component]).ptr;
+                *p++ = component < 2 ? ' ' : '\n';
+            }
+
+            _Commit(p);
+        }
+    }
+
+    GLuint offset = 0;
+
+    for (vector<const TriangulatedMesh3*>::const_iterator mit = meshes.begin(); mit != meshes.end(); ++mit)
+    {
+        if (!*mit)
+            continue;
+
+        for (vector<TriangularFace>::const_iterator fit = (*mit)->_face.begin(); fit != (*mit)->_face.end(); ++fit)
+        {
+            char *p = _Reserve(MAXIMAL_RECORD_SIZE), *end = p + MAXIMAL_RECORD_SIZE;
+
+            *p++ = '3';
+            for (GLuint node = 0; node < 3; ++node)
+            {
+                *p++ = ' ';
+                p = to_chars(p, end, offset + (*fit)[node]).ptr;
+            }
+            *p++ = '\n';
+
+            _Commit(p);
+        }
+
+        offset += (GLuint)(*mit)->_vertex.size();
+    }
+}
+
+GLvoid MeshExporter::_WritePLY(const vector<const TriangulatedMesh3*>& meshes, GLuint vertex_count, GLuint face_count)
+{
+    string header =
+            "ply\n"
+            "format binary_little_endian 1.0\n"
+            "element vertex " + to_string(vertex_count) + "\n"
+            "property float x\n"
+            "property float y\n"
+            "property float z\n"
+            "property float nx\n"
+            "property float ny\n"
+            "property float nz\n"
+            "element face " + to_string(face_count) + "\n"
+            "property list uchar int vertex_indices\n"
+            "end_header\n";
+    _Write(header.data(), header.size());
+
+    for (vector<const TriangulatedMesh3*>::const_iterator mit = meshes.begin(); mit != meshes.end(); ++mit)
+    {
+        if (!*mit)
+            continue;
+
+        const vector<DCoordinate3> &vertex = (*mit)->_vertex, &normal = (*mit)->_normal;
+
+        for (size_t i = 0; i < vertex.size(); ++i)
+        {
+            char *p = _Reserve(6 * sizeof(GLfloat));
+
+            for (GLuint component = 0; component < 3; ++component)
+                p = StoreFloat(p, (GLfloat)vertex[i][component]);
+
+            for (GLuint component = 0; component < 3; ++component)
+                p = StoreFloat(p, i < normal.size() ? (GLfloat)normal[i][component] : 0.0f);
+
+            _Commit(p);
+        }
+    }
+
+    GLuint offset = 0;
+
+    for (vector<const TriangulatedMesh3*>::const_iterator mit = meshes.begin(); mit != meshes.end(); ++mit)
+    {
+        if (!*mit)
+            continue;
+
+        for (vector<TriangularFace>::const_iterator fit = (*mit)->_face.begin(); fit != (*mit)->_face.end(); ++fit)
+        {
+            char *p = _Reserve(1 + 3 * sizeof(GLuint));
+
+            *p++ = 3;
+            for (GLuint node = 0; node < 3; ++node)
+                p = StoreUInt32(p, offset + (*fit)[node]);
+
+            _Commit(p);
+        }
+
+        offset += (GLuint)(*mit)->_vertex.size();
+    }
+}
+
+GLvoid MeshExporter::_WriteSTL(const vector<const TriangulatedMesh3*>& meshes, GLuint face_count)
+{
+    // 80-byte header that must not start with "solid", followed by the number of triangles
+    char *p = _Reserve(84);
+    memset(p, 0, 84);
+    memcpy(p, "binary STL", 10);
+    StoreUInt32(p + 80, face_count);
+    _Commit(p + 84);
+
+    for (vector<const TriangulatedMesh3*>::const_iterator mit = meshes.begin(); mit != meshes.end(); ++mit)
+    {
+        if (!*mit)
+            continue;
+
+        const vector<DCoordinate3> &vertex = (*mit)->_vertex;
+
+        for (vector<TriangularFace>::const_iterator fit = (*mit)->_face.begin(); fit != (*mit)->_face.end(); ++fit)
+        {
+            const DCoordinate3 &a = vertex[(*fit)[0]], &b = vertex[(*fit)[1]], &c = vertex[(*fit)[2]];
+
+            DCoordinate3 n = b;
+            n -= a;
+
+            DCoordinate3 q = c;
+            q -= a;
+
+            n ^= q;
+            n.normalize();
+
+            p = _Reserve(50);
+
+            for (GLuint component = 0; component < 3; ++component)
+                p = StoreFloat(p, isfinite(n[component]) ? (GLfloat)n[component] : 0.0f);
+
+            for (GLuint node = 0; node < 3; ++node)
+                for (GLuint component = 0; component < 3; ++component)
+                    p = StoreFloat(p, (GLfloat)vertex[(*fit)[node]][component]);
+
+            // attribute byte count
+            *p++ = 0;
+            *p++ = 0;
+
+            _Commit(p);
+        }
+    }
+}
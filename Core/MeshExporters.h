@@ -0,0 +1,67 @@
+#pragma once
+
+#include "TriangulatedMeshes3.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace cagd
+{
+    // streaming exporter of triangulated meshes: the records are formatted by std::to_chars (or copied
+    // in binary form) into a large buffer, that is written into an unbuffered file by a single call
+    // whenever it is full; the buffer is reused by consecutive exports; several meshes are exported as
+    // a single one without merging them in memory, i.e., their vertices are appended one after the
+    // other, while the indices of their faces are shifted accordingly
+    //
+    // supported formats:
+    // - OFF:  text, the coordinates are written in the shortest form that is read back exactly
+    // - PLY:  binary little-endian, with float coordinates and unit normal vectors per vertex
+    // - STL:  binary little-endian, with float coordinates and unit normal vectors per triangle
+    class MeshExporter
+    {
+    public:
+        enum class Format
+        {
+            OFF = 0,
+            PLY = 1,
+            STL = 2
+        };
+
+        // special/default constructor
+        MeshExporter(Format format = Format::OFF, GLuint buffer_size = 1 << 20);
+
+        // the buffer is owned by a single instance
+        MeshExporter(const MeshExporter&) = delete;
+        MeshExporter& operator =(const MeshExporter&) = delete;
+
+        // exports the given meshes into a single file, null pointers are skipped
+        GLboolean Export(const std::string& file_name, const std::vector<const TriangulatedMesh3*>& meshes);
+        GLboolean Export(const std::string& file_name, const TriangulatedMesh3& mesh);
+
+        // set/get properties
+        GLvoid SetFormat(Format format);
+        Format GetFormat() const;
+
+        // destructor
+        ~MeshExporter();
+
+    private:
+        Format              _format;
+        std::vector<char>   _buffer;
+        std::size_t         _size;      // number of buffered bytes
+        std::FILE*          _file;
+        GLboolean           _is_valid;  // no write has failed since the file was opened
+
+        // returns a pointer to at least byte_count free bytes of the buffer, the buffered bytes are
+        // written if necessary; the bytes are buffered by the method _Commit
+        char*     _Reserve(std::size_t byte_count);
+        GLvoid    _Commit(char* end);
+
+        GLvoid    _Write(const char* data, std::size_t byte_count);
+        GLvoid    _Flush();
+
+        GLvoid    _WriteOFF(const std::vector<const TriangulatedMesh3*>& meshes, GLuint vertex_count, GLuint face_count);
+        GLvoid    _WritePLY(const std::vector<const TriangulatedMesh3*>& meshes, GLuint vertex_count, GLuint face_count);
+        GLvoid    _WriteSTL(const std::vector<const TriangulatedMesh3*>& meshes, GLuint face_count);
+    };
+}
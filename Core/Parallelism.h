@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <GL/glew.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace cagd
+{
+    // the GenerateImage methods distribute the rows of their subdivision grids among OpenMP threads;
+    // every sample writes to fixed array positions, therefore the output layout does not depend on
+    // the number of threads; in builds without OpenMP support the images are generated sequentially,
+    // and the thread counts, which appear only in the ignored pragmas, are declared [[maybe_unused]]
+
+    // minimal number of samples per thread, smaller images are not worth the start-up of a team
+    static const GLuint TESSELLATION_SAMPLES_PER_THREAD = 1024;
+
+    inline std::atomic<GLuint>& _TessellationThreadCountSetting()
+    {
+        static std::atomic<GLuint> thread_count(0);
+        return thread_count;
+    }
+
+    // sets the number of tessellation threads, the value 0 selects the default of the OpenMP runtime
+    inline GLvoid SetTessellationThreadCount(GLuint thread_count)
+    {
+        _TessellationThreadCountSetting() = thread_count;
+    }
+
+    inline GLuint GetTessellationThreadCount()
+    {
+        return _TessellationThreadCountSetting();
+    }
+
+    // number of threads that should process the given number of work items, if every thread has to
+    // get at least the given number of items
+    inline GLint ParallelThreadCount(GLuint item_count, GLuint items_per_thread)
+    {
+#ifdef _OPENMP
+        GLint thread_count = (GLint)GetTessellationThreadCount();
+        if (!thread_count)
+            thread_count = omp_get_max_threads();
+
+        return std::max(1, std::min(thread_count, (GLint)(item_count / std::max(1u, items_per_thread))));
+#else
+        (void)item_count;
+        (void)items_per_thread;
+        return 1;
+#endif
+    }
+
+    // number of threads that should generate an image of the given number of samples
+    inline GLint TessellationThreadCount(GLuint sample_count)
+    {
+        return ParallelThreadCount(sample_count, TESSELLATION_SAMPLES_PER_THREAD);
+    }
+}
@@ -1,4 +1,6 @@
 #include "RealSquareMatrices.h"
+#include "CpuFeatures.h"
+#include <algorithm>
 
 // using namespace cagd;
 using namespace std;
@@ -6,13 +8,72 @@ using namespace std;
 namespace cagd
 {
 
-RealSquareMatrix::~RealSquareMatrix()
+const GLuint RealSquareMatrix::LU_BLOCK_SIZE;
+const GLuint RealSquareMatrix::LU_TILE_SIZE;
+const GLuint RealSquareMatrix::LU_PARALLEL_SIZE;
+const GLuint RealSquareMatrix::LU_BAND_RATIO;
+const GLuint RealSquareMatrix::SOLVE_BLOCK_ELEMENT_COUNT;
+const GLuint RealSquareMatrix::SOLVE_MINIMAL_BLOCK_SIZE;
+const GLuint RealSquareMatrix::SOLVE_TILE_SIZE;
+
+// scalar components of the right-hand side types handled by the batched solvers
+static inline GLdouble& Component(GLdouble& value, GLuint)
+{
+    return value;
+}
+
+static inline GLdouble Component(const GLdouble& value, GLuint)
 {
-    for (unsigned i = 0; i < _row_count; i++)
+    return value;
+}
+
+static inline GLdouble& Component(DCoordinate3& value, GLuint c)
+{
+    return value[c];
+}
+
+static inline GLdouble Component(const DCoordinate3& value, GLuint c)
+{
+    return value[c];
+}
+
+#if CAGD_AVX2_KERNELS
+// the AVX2 variant of the kernel below, it processes the first count - count % 8 elements and
+// returns their number
+CAGD_TARGET_AVX2 static GLuint SubtractMultipleAVX2(GLdouble *x, const GLdouble *y, GLdouble factor, GLuint count)
+{
+    GLuint k = 0;
+
+    __m256d f = _mm256_set1_pd(factor);
+    for (; k + 8 <= count; k += 8)
     {
-        _data[i].clear();
+        __m256d x0 = _mm256_loadu_pd(x + k), x1 = _mm256_loadu_pd(x + k + 4);
+        x0 = _mm256_fnmadd_pd(f, _mm256_loadu_pd(y + k), x0);
+        x1 = _mm256_fnmadd_pd(f, _mm256_loadu_pd(y + k + 4), x1);
+        _mm256_storeu_pd(x + k, x0);
+        _mm256_storeu_pd(x + k + 4, x1);
     }
 
+    return k;
+}
+#endif
+
+// x[k] -= factor * y[k], k = 0, 1, ..., count - 1, the kernel of the batched substitutions
+static inline GLvoid SubtractMultiple(GLdouble *x, const GLdouble *y, GLdouble factor, GLuint count)
+{
+    GLuint k = 0;
+
+#if CAGD_AVX2_KERNELS
+    if (count >= 8 && ProcessorSupportsAVX2())
+        k = SubtractMultipleAVX2(x, y, factor, count);
+#endif
+
+    for (; k < count; ++k)
+        x[k] -= factor * y[k];
+}
+
+RealSquareMatrix::~RealSquareMatrix()
+{
     _row_count = _column_count = 0;
 
     _data.clear();
@@ -21,13 +82,20 @@ RealSquareMatrix::~RealSquareMatrix()
 RealSquareMatrix::RealSquareMatrix(GLuint size)
     : Matrix<GLdouble>(size, size)
     , _lu_decomposition_is_done(GL_FALSE)
+    , _condition_number(numeric_limits<GLdouble>::infinity())
+    , _lower_bandwidth(size ? size - 1 : 0)
+    , _upper_bandwidth(size ? size - 1 : 0)
 {
 }
 
 RealSquareMatrix::RealSquareMatrix(const RealSquareMatrix& rhs)
     : Matrix<GLdouble>(rhs)
     , _lu_decomposition_is_done(rhs._lu_decomposition_is_done)
+    , _condition_number(rhs._condition_number)
     , _row_permutation(rhs._row_permutation)
+    , _lower_bandwidth(rhs._lower_bandwidth)
+    , _upper_bandwidth(rhs._upper_bandwidth)
+    , _lower_begin(rhs._lower_begin)
 {
 }
 
@@ -37,37 +105,62 @@ RealSquareMatrix& RealSquareMatrix::operator =(const RealSquareMatrix& rhs)
     {
         Matrix<GLdouble>::operator=(rhs);
         _lu_decomposition_is_done = rhs._lu_decomposition_is_done;
+        _condition_number = rhs._condition_number;
         _row_permutation = rhs._row_permutation;
+        _lower_bandwidth = rhs._lower_bandwidth;
+        _upper_bandwidth = rhs._upper_bandwidth;
+        _lower_begin = rhs._lower_begin;
     }
     return *this;
 }
 
-GLboolean RealSquareMatrix::ResizeRows(GLuint row_count)
+RealSquareMatrix::RealSquareMatrix(RealSquareMatrix&& rhs) noexcept
+    : Matrix<GLdouble>(std::move(rhs))
+    , _lu_decomposition_is_done(rhs._lu_decomposition_is_done)
+    , _condition_number(rhs._condition_number)
+    , _row_permutation(std::move(rhs._row_permutation))
+    , _lower_bandwidth(rhs._lower_bandwidth)
+    , _upper_bandwidth(rhs._upper_bandwidth)
+    , _lower_begin(std::move(rhs._lower_begin))
+{
+    rhs._lu_decomposition_is_done = GL_FALSE;
+}
+
+RealSquareMatrix& RealSquareMatrix::operator =(RealSquareMatrix&& rhs) noexcept
 {
-//    return Matrix<GLdouble>::ResizeRows(row_count) &&
-//            Matrix<GLdouble>::ResizeColumns(row_count);
-    _row_count = row_count;
-    _column_count = row_count;
-    _data.resize(_row_count);
-    for (unsigned i = 0; i < _row_count; i++)
+    if (this != &rhs)
     {
-        _data[i].resize(_column_count);
+        Matrix<GLdouble>::operator=(std::move(rhs));
+        _lu_decomposition_is_done = rhs._lu_decomposition_is_done;
+        _condition_number = rhs._condition_number;
+        _row_permutation.swap(rhs._row_permutation);
+        _lower_bandwidth = rhs._lower_bandwidth;
+        _upper_bandwidth = rhs._upper_bandwidth;
+        _lower_begin.swap(rhs._lower_begin);
+
+        rhs._lu_decomposition_is_done = GL_FALSE;
+        rhs._row_permutation.clear();
+        rhs._lower_begin.clear();
     }
+    return *this;
+}
+
+GLboolean RealSquareMatrix::ResizeRows(GLuint row_count)
+{
+    // the common elements are preserved, but a previous factorization is no longer valid
+    Matrix<GLdouble>::ResizeRows(row_count);
+    Matrix<GLdouble>::ResizeColumns(row_count);
+    _lu_decomposition_is_done = GL_FALSE;
 
     return GL_TRUE;
 }
 
 GLboolean RealSquareMatrix::ResizeColumns(GLuint column_count)
 {
-//    return Matrix<GLdouble>::ResizeRows(row_count) &&
-//            Matrix<GLdouble>::ResizeColumns(row_count);
-    _row_count = column_count;
-    _column_count = column_count;
-    _data.resize(_row_count);
-    for (unsigned i = 0; i < _row_count; i++)
-    {
-        _data[i].resize(_column_count);
-    }
+    // the common elements are preserved, but a previous factorization is no longer valid
+    Matrix<GLdouble>::ResizeRows(column_count);
+    Matrix<GLdouble>::ResizeColumns(column_count);
+    _lu_decomposition_is_done = GL_FALSE;
 
     return GL_TRUE;
 }
@@ -82,25 +175,37 @@ GLboolean RealSquareMatrix::PerformLUDecomposition()
 
     const GLdouble tiny = numeric_limits<GLdouble>::min();
 
-    GLuint size = (GLuint)_data.size();
+    GLuint size = _row_count;
     vector<GLdouble> implicit_scaling_of_each_row(size);
 
     _row_permutation.resize(size);
 
-    GLdouble row_interchanges = 1.0;
+    //--------------------------------------------------------------------------
+    // loop over rows to get the implicit scaling information and the bandwidths
+    //--------------------------------------------------------------------------
+    GLuint lower_bandwidth = 0, upper_bandwidth = 0;
+
+    // the 1-norm of the original matrix is needed by the condition number estimate
+    vector<GLdouble> column_sums(size, 0.0);
 
-    //-------------------------------------------------------
-    // loop over rows to get the implicit scaling information
-    //-------------------------------------------------------
     vector<GLdouble>::iterator its = implicit_scaling_of_each_row.begin();
-    for (vector<vector<GLdouble> >::const_iterator itr = _data.begin(); itr < _data.end(); ++itr)
+    for (GLuint i = 0; i < size; ++i)
     {
+        const GLdouble *row = &_data[i * size];
+
         GLdouble big = 0.0;
-        for (vector<GLdouble>::const_iterator itc = itr->begin(); itc < itr->end(); ++itc)
+        GLuint first = size, last = 0;
+        for (GLuint j = 0; j < size; ++j)
         {
-            GLdouble temp = abs(*itc);
+            GLdouble temp = abs(row[j]);
             if (temp > big)
                     big = temp;
+            column_sums[j] += temp;
+            if (temp != 0.0)
+            {
+                first = min(first, j);
+                last = j;
+            }
         }
 
         if (big == 0.0)
@@ -110,18 +215,196 @@ GLboolean RealSquareMatrix::PerformLUDecomposition()
         }
         *its = 1.0 / big;
         ++its;
+
+        if (first < i)
+            lower_bandwidth = max(lower_bandwidth, i - first);
+        if (last > i)
+            upper_bandwidth = max(upper_bandwidth, last - i);
+    }
+
+    GLdouble one_norm = *max_element(column_sums.begin(), column_sums.end());
+
+    if (LU_BAND_RATIO * (lower_bandwidth + upper_bandwidth + 1) <= size)
+    {
+        _lower_bandwidth = lower_bandwidth;
+        _upper_bandwidth = upper_bandwidth;
+
+        _performBandedLUDecomposition(implicit_scaling_of_each_row);
+
+        _lu_decomposition_is_done = GL_TRUE;
+
+        _condition_number = one_norm * _estimateInverseOneNorm();
+
+        return GL_TRUE;
     }
 
-    //-----------------------------------
-    // search for the largest pivot element
-    //-----------------------------------
+    // the dense elimination stores a full row of multipliers in every row of L
+    _lower_bandwidth = _upper_bandwidth = size - 1;
+    _lower_begin.assign(size, 0);
+
+    //--------------------------------------------------------------------------------
+    // right-looking blocked elimination: a panel of LU_BLOCK_SIZE columns is factored,
+    // the corresponding block row of U is solved, then the trailing submatrix is
+    // updated by a single rank-LU_BLOCK_SIZE product; every element receives the same
+    // sequence of updates as in the unblocked algorithm
+    //--------------------------------------------------------------------------------
+    for (GLuint block_begin = 0; block_begin < size; block_begin += LU_BLOCK_SIZE)
+    {
+        GLuint block_end = min(block_begin + LU_BLOCK_SIZE, size);
+
+        // panel factorization
+        for (GLuint k = block_begin; k < block_end; ++k)
+        {
+            // search for the largest (implicitly scaled) pivot element
+            GLuint imax = k;
+            GLdouble big = 0.0;
+            for (GLuint i = k; i < size; ++i)
+            {
+                GLdouble temp = implicit_scaling_of_each_row[i] * abs(_data[i * size + k]);
+                if (temp > big)
+                {
+                    big = temp;
+                    imax = i;
+                }
+            }
+
+            // do we need to interchange rows? (whole rows are interchanged, thus the stored
+            // multipliers follow their rows as well)
+            if (k != imax)
+            {
+                swap_ranges(_data.begin() + imax * size, _data.begin() + (imax + 1) * size,
+                            _data.begin() + k * size);
+                // also interchange the scale factor
+                implicit_scaling_of_each_row[imax] = implicit_scaling_of_each_row[k];
+            }
+
+            GLdouble *row_k = &_data[k * size];
+
+            _row_permutation[k] = imax;
+            if (row_k[k] == 0.0)
+                row_k[k] = tiny;
+
+            for (GLuint i = k + 1; i < size; ++i)
+            {
+                GLdouble *row_i = &_data[i * size];
+
+                // divide by pivot element
+                GLdouble temp = row_i[k] /= row_k[k];
+
+                // reduce the remaining columns of the panel
+                for (GLuint j = k + 1; j < block_end; ++j)
+                    row_i[j] -= temp * row_k[j];
+            }
+        }
+
+        if (block_end == size)
+            break;
+
+        // block row of U: U_12 = L_11^{-1} A_12
+        for (GLuint k = block_begin; k < block_end; ++k)
+        {
+            const GLdouble *row_k = &_data[k * size];
+            for (GLuint i = k + 1; i < block_end; ++i)
+            {
+                GLdouble *row_i = &_data[i * size];
+                GLdouble temp = row_i[k];
+                for (GLuint j = block_end; j < size; ++j)
+                    row_i[j] -= temp * row_k[j];
+            }
+        }
+
+        // trailing update A_22 -= L_21 U_12, the rows are independent, the columns are
+        // processed in tiles such that the used part of U_12 stays in cache
+        GLint trailing_begin = (GLint)block_end, trailing_end = (GLint)size;
+
+        #pragma omp parallel for schedule(static) if((size - block_end) >= LU_PARALLEL_SIZE)
+        for (GLint i = trailing_begin; i < trailing_end; ++i)
+        {
+            GLdouble *row_i = &_data[i * size];
+            for (GLuint tile_begin = block_end; tile_begin < size; tile_begin += LU_TILE_SIZE)
+            {
+                GLuint tile_end = min(tile_begin + LU_TILE_SIZE, size);
+                for (GLuint k = block_begin; k < block_end; ++k)
+                {
+                    const GLdouble *row_k = &_data[k * size];
+                    GLdouble temp = row_i[k];
+                    for (GLuint j = tile_begin; j < tile_end; ++j)
+                        row_i[j] -= temp * row_k[j];
+                }
+            }
+        }
+    }
+
+    _lu_decomposition_is_done = GL_TRUE;
+
+    _condition_number = one_norm * _estimateInverseOneNorm();
+
+    return GL_TRUE;
+}
+
+GLboolean RealSquareMatrix::SolveLinearSystem(const Matrix<GLdouble>& b, Matrix<GLdouble>& x, GLboolean represent_solutions_as_columns)
+{
+    if (!_lu_decomposition_is_done)
+        if (!PerformLUDecomposition())
+            return GL_FALSE;
+
+    return _solveBatched(b, x, represent_solutions_as_columns, 1);
+}
+
+GLboolean RealSquareMatrix::SolveLinearSystem(const Matrix<DCoordinate3>& b, Matrix<DCoordinate3>& x, GLboolean represent_solutions_as_columns)
+{
+    if (!_lu_decomposition_is_done)
+        if (!PerformLUDecomposition())
+            return GL_FALSE;
+
+    return _solveBatched(b, x, represent_solutions_as_columns, 3);
+}
+
+GLboolean RealSquareMatrix::SolveLinearSystem(const Matrix<GLdouble>& b, Matrix<GLdouble>& x, GLboolean represent_solutions_as_columns) const
+{
+    return _solveBatched(b, x, represent_solutions_as_columns, 1);
+}
+
+GLboolean RealSquareMatrix::SolveLinearSystem(const Matrix<DCoordinate3>& b, Matrix<DCoordinate3>& x, GLboolean represent_solutions_as_columns) const
+{
+    return _solveBatched(b, x, represent_solutions_as_columns, 3);
+}
+
+GLboolean RealSquareMatrix::IsLUDecompositionDone() const
+{
+    return _lu_decomposition_is_done;
+}
+
+GLboolean RealSquareMatrix::IsBanded() const
+{
+    return _lu_decomposition_is_done && _lower_bandwidth + _upper_bandwidth + 1 < _row_count;
+}
+
+// the same elimination with scaled partial pivoting as the dense one, but in the k-th step
+// only the rows k + 1,..., k + lower_bandwidth can have nonzero elements in the k-th column,
+// and after the interchanges the nonzeros of the pivot row end in the column
+// k + lower_bandwidth + upper_bandwidth
+GLvoid RealSquareMatrix::_performBandedLUDecomposition(vector<GLdouble>& implicit_scaling_of_each_row)
+{
+    const GLdouble tiny = numeric_limits<GLdouble>::min();
+
+    GLuint size = _row_count;
+
+    // rows without multipliers
+    _lower_begin.resize(size);
+    for (GLuint i = 0; i < size; ++i)
+        _lower_begin[i] = i;
+
     for (GLuint k = 0; k < size; ++k)
     {
+        GLuint row_end = min(size, k + _lower_bandwidth + 1);
+        GLuint column_end = _upperEnd(k);
+
         GLuint imax = k;
         GLdouble big = 0.0;
-        for (GLuint i = k; i < size; ++i)
+        for (GLuint i = k; i < row_end; ++i)
         {
-            GLdouble temp = implicit_scaling_of_each_row[i] * abs(_data[i][k]);
+            GLdouble temp = implicit_scaling_of_each_row[i] * abs(_data[i * size + k]);
             if (temp > big)
             {
                 big = temp;
@@ -129,38 +412,372 @@ GLboolean RealSquareMatrix::PerformLUDecomposition()
             }
         }
 
-        // do we need to interchange rows?
+        // both rows vanish outside of the columns [min(lower_begin), column_end)
         if (k != imax)
         {
-            for (GLuint j = 0; j < size; ++j)
-            {
-                GLdouble temp = _data[imax][j];
-                _data[imax][j] = _data[k][j];
-                _data[k][j] = temp;
-            }
-            // change the parity of row_interchanges
-            row_interchanges = -row_interchanges;
-            // also interchange the scale factor
+            GLuint column_begin = min(_lower_begin[k], _lower_begin[imax]);
+            swap_ranges(_data.begin() + imax * size + column_begin, _data.begin() + imax * size + column_end,
+                        _data.begin() + k * size + column_begin);
+            swap(_lower_begin[k], _lower_begin[imax]);
             implicit_scaling_of_each_row[imax] = implicit_scaling_of_each_row[k];
         }
 
+        GLdouble *row_k = &_data[k * size];
+
         _row_permutation[k] = imax;
-        if (_data[k][k] == 0.0)
-            _data[k][k] = tiny;
+        if (row_k[k] == 0.0)
+            row_k[k] = tiny;
 
-        for (GLuint i = k + 1; i < size; ++i)
+        for (GLuint i = k + 1; i < row_end; ++i)
         {
-            // divide by pivot element
-            GLdouble temp = _data[i][k] /= _data[k][k];
+            GLdouble *row_i = &_data[i * size];
+
+            GLdouble temp = row_i[k] /= row_k[k];
+            _lower_begin[i] = min(_lower_begin[i], k);
 
-            // reduce remaining submatrix
-            for (GLuint j = k + 1; j < size; ++j)
-                _data[i][j] -= temp * _data[k][j];
+            for (GLuint j = k + 1; j < column_end; ++j)
+                row_i[j] -= temp * row_k[j];
         }
     }
+}
 
-    _lu_decomposition_is_done = GL_TRUE;
+template <class T>
+GLboolean RealSquareMatrix::_solveBatched(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns, GLuint component_count) const
+{
+    if (!_lu_decomposition_is_done)
+        return GL_FALSE;
+
+    GLuint size = _row_count;
+    GLuint rhs_count;
+
+    if (represent_solutions_as_columns)
+    {
+        if (b.GetRowCount() != size)
+            return GL_FALSE;
+        rhs_count = b.GetColumnCount();
+    }
+    else
+    {
+        if (b.GetColumnCount() != size)
+            return GL_FALSE;
+        rhs_count = b.GetRowCount();
+    }
+
+    if (&x != &b)
+    {
+        if (x.GetRowCount() != b.GetRowCount())
+            x.ResizeRows(b.GetRowCount());
+        if (x.GetColumnCount() != b.GetColumnCount())
+            x.ResizeColumns(b.GetColumnCount());
+    }
+
+    if (!rhs_count)
+        return GL_TRUE;
+
+    // the right-hand sides are processed in blocks that fit into the cache, the blocks are
+    // independent of each other
+    GLuint block_size = SOLVE_BLOCK_ELEMENT_COUNT / (component_count * size);
+    block_size = max(SOLVE_MINIMAL_BLOCK_SIZE, block_size - block_size % 8);
+    block_size = min(block_size, rhs_count);
+
+    GLint block_count = (GLint)((rhs_count + block_size - 1) / block_size);
+
+    const T *b_data = b.GetData();
+    T       *x_data = x.GetData();
+
+    #pragma omp parallel if(block_count > 1 && size >= LU_BLOCK_SIZE)
+    {
+        // the component planes of a block are compact, the right-hand sides are scattered into
+        // them and the solutions are gathered directly into x, thus b is never copied into x
+        vector<GLdouble> planes((size_t)component_count * size * block_size);
+
+        #pragma omp for schedule(static)
+        for (GLint block = 0; block < block_count; ++block)
+        {
+            GLuint first = block * block_size;
+            GLuint count = min(block_size, rhs_count - first);
+
+            for (GLuint c = 0; c < component_count; ++c)
+            {
+                GLdouble *plane = &planes[(size_t)c * size * block_size];
+                for (GLuint i = 0; i < size; ++i)
+                    for (GLuint k = 0; k < count; ++k)
+                        plane[i * block_size + k] = Component(represent_solutions_as_columns ?
+                                                              b_data[i * rhs_count + first + k] :
+                                                              b_data[(first + k) * size + i], c);
+            }
+
+            _solveComponentPlanes(component_count, count, block_size, planes.data());
+
+            for (GLuint c = 0; c < component_count; ++c)
+            {
+                const GLdouble *plane = &planes[(size_t)c * size * block_size];
+                for (GLuint i = 0; i < size; ++i)
+                    for (GLuint k = 0; k < count; ++k)
+                        Component(represent_solutions_as_columns ?
+                                  x_data[i * rhs_count + first + k] :
+                                  x_data[(first + k) * size + i], c) = plane[i * block_size + k];
+            }
+        }
+    }
 
     return GL_TRUE;
 }
+
+GLvoid RealSquareMatrix::_solveComponentPlanes(GLuint component_count, GLuint count, GLuint stride, GLdouble *planes) const
+{
+    GLuint size = _row_count;
+    size_t plane_size = (size_t)size * stride;
+
+    // x_i -= factor * x_j in every component plane
+    auto subtract = [&](GLuint i, GLuint j, GLdouble factor)
+    {
+        if (factor == 0.0)
+            return;
+
+        for (GLuint c = 0; c < component_count; ++c)
+            SubtractMultiple(planes + c * plane_size + (size_t)i * stride,
+                             planes + c * plane_size + (size_t)j * stride, factor, count);
+    };
+
+    // the row interchanges are applied in the same order as they were performed by the
+    // decomposition (at the i-th step both interchanged rows are still untouched, thus they
+    // can be applied before the substitutions)
+    for (GLuint i = 0; i < size; ++i)
+    {
+        GLuint ip = _row_permutation[i];
+        if (ip != i)
+        {
+            for (GLuint c = 0; c < component_count; ++c)
+            {
+                GLdouble *x_i = planes + c * plane_size + (size_t)i * stride;
+                swap_ranges(x_i, x_i + count, planes + c * plane_size + (size_t)ip * stride);
+            }
+        }
+    }
+
+    // the band of the factors is narrow, thus the rows read by the substitutions stay in cache
+    if (IsBanded())
+    {
+        for (GLuint i = 0; i < size; ++i)
+        {
+            const GLdouble *lu_row = &_data[i * size];
+            for (GLuint j = _lower_begin[i]; j < i; ++j)
+                subtract(i, j, lu_row[j]);
+        }
+
+        for (GLint i = (GLint)size - 1; i >= 0; --i)
+        {
+            const GLdouble *lu_row = &_data[i * size];
+            GLuint upper_end = _upperEnd(i);
+            for (GLuint j = i + 1; j < upper_end; ++j)
+                subtract(i, j, lu_row[j]);
+
+            GLdouble pivot = lu_row[i];
+            for (GLuint c = 0; c < component_count; ++c)
+            {
+                GLdouble *x_i = planes + c * plane_size + (size_t)i * stride;
+                for (GLuint k = 0; k < count; ++k)
+                    x_i[k] /= pivot;
+            }
+        }
+
+        return;
+    }
+
+    // the substitutions sweep the factors in square tiles of SOLVE_TILE_SIZE rows, such that the
+    // rows of the block that are updated and read by a tile stay in cache
+
+    // forward substitution with the unit lower triangular factor
+    for (GLuint tile_begin = 0; tile_begin < size; tile_begin += SOLVE_TILE_SIZE)
+    {
+        GLuint tile_end = min(tile_begin + SOLVE_TILE_SIZE, size);
+
+        for (GLuint source_begin = 0; source_begin < tile_begin; source_begin += SOLVE_TILE_SIZE)
+        {
+            GLuint source_end = source_begin + SOLVE_TILE_SIZE;
+            for (GLuint i = tile_begin; i < tile_end; ++i)
+            {
+                const GLdouble *lu_row = &_data[i * size];
+                for (GLuint j = source_begin; j < source_end; ++j)
+                    subtract(i, j, lu_row[j]);
+            }
+        }
+
+        for (GLuint i = tile_begin; i < tile_end; ++i)
+        {
+            const GLdouble *lu_row = &_data[i * size];
+            for (GLuint j = tile_begin; j < i; ++j)
+                subtract(i, j, lu_row[j]);
+        }
+    }
+
+    // back substitution with the upper triangular factor
+    for (GLint tile = (GLint)((size - 1) / SOLVE_TILE_SIZE); tile >= 0; --tile)
+    {
+        GLuint tile_begin = tile * SOLVE_TILE_SIZE;
+        GLuint tile_end = min(tile_begin + SOLVE_TILE_SIZE, size);
+
+        for (GLuint source_begin = tile_end; source_begin < size; source_begin += SOLVE_TILE_SIZE)
+        {
+            GLuint source_end = min(source_begin + SOLVE_TILE_SIZE, size);
+            for (GLuint i = tile_begin; i < tile_end; ++i)
+            {
+                const GLdouble *lu_row = &_data[i * size];
+                for (GLuint j = source_begin; j < source_end; ++j)
+                    subtract(i, j, lu_row[j]);
+            }
+        }
+
+        for (GLint i = (GLint)tile_end - 1; i >= (GLint)tile_begin; --i)
+        {
+            const GLdouble *lu_row = &_data[i * size];
+            for (GLuint j = i + 1; j < tile_end; ++j)
+                subtract(i, j, lu_row[j]);
+
+            GLdouble pivot = lu_row[i];
+            for (GLuint c = 0; c < component_count; ++c)
+            {
+                GLdouble *x_i = planes + c * plane_size + (size_t)i * stride;
+                for (GLuint k = 0; k < count; ++k)
+                    x_i[k] /= pivot;
+            }
+        }
+    }
+}
+
+GLdouble RealSquareMatrix::GetConditionNumberEstimate() const
+{
+    return _lu_decomposition_is_done ? _condition_number : numeric_limits<GLdouble>::infinity();
+}
+
+// solves A x = b in place by means of the stored LU decomposition
+GLvoid RealSquareMatrix::_solve(vector<GLdouble>& x) const
+{
+    GLuint size = _row_count;
+
+    for (GLuint i = 0; i < size; ++i)
+    {
+        const GLdouble *lu_row = &_data[i * size];
+        GLdouble sum = x[_row_permutation[i]];
+        x[_row_permutation[i]] = x[i];
+        for (GLuint j = _lower_begin[i]; j < i; ++j)
+            sum -= lu_row[j] * x[j];
+        x[i] = sum;
+    }
+
+    for (GLint i = (GLint)size - 1; i >= 0; --i)
+    {
+        const GLdouble *lu_row = &_data[i * size];
+        GLdouble sum = x[i];
+        GLuint upper_end = _upperEnd(i);
+        for (GLuint j = i + 1; j < upper_end; ++j)
+            sum -= lu_row[j] * x[j];
+        x[i] = sum / lu_row[i];
+    }
+}
+
+// solves A^T x = b in place, i.e., U^T w = b, L^T v = w, and x is v permuted backwards
+GLvoid RealSquareMatrix::_solveTransposed(vector<GLdouble>& x) const
+{
+    GLuint size = _row_count;
+
+    for (GLuint i = 0; i < size; ++i)
+    {
+        x[i] /= _data[i * size + i];
+        const GLdouble *lu_row = &_data[i * size];
+        GLuint upper_end = _upperEnd(i);
+        for (GLuint j = i + 1; j < upper_end; ++j)
+            x[j] -= lu_row[j] * x[i];
+    }
+
+    for (GLint i = (GLint)size - 1; i >= 0; --i)
+    {
+        const GLdouble *lu_row = &_data[i * size];
+        for (GLint j = (GLint)_lower_begin[i]; j < i; ++j)
+            x[j] -= lu_row[j] * x[i];
+    }
+
+    for (GLint i = (GLint)size - 1; i >= 0; --i)
+        swap(x[i], x[_row_permutation[i]]);
+}
+
+// Hager's estimate of the 1-norm of the inverse (as refined by Higham), it needs only a few
+// solves with the already determined factors, i.e., O(size^2) operations
+GLdouble EstimateInverseOneNorm(
+        GLuint size,
+        const function<GLvoid(vector<GLdouble>&)>& solve,
+        const function<GLvoid(vector<GLdouble>&)>& solve_transposed)
+{
+    vector<GLdouble> x(size, 1.0 / size), z(size);
+
+    GLdouble estimate = 0.0;
+    GLuint   previous_index = size;
+
+    for (GLuint iteration = 0; iteration < 5; ++iteration)
+    {
+        solve(x);
+
+        estimate = 0.0;
+        for (GLuint i = 0; i < size; ++i)
+        {
+            estimate += abs(x[i]);
+            z[i] = x[i] >= 0.0 ? 1.0 : -1.0;
+        }
+
+        solve_transposed(z);
+
+        GLuint index = 0;
+        for (GLuint i = 1; i < size; ++i)
+            if (abs(z[i]) > abs(z[index]))
+                index = i;
+
+        if (index == previous_index)
+            break;
+
+        // z^T x, where x is the current unit vector (or the initial uniform vector)
+        GLdouble product = 0.0;
+        if (iteration == 0)
+        {
+            for (GLuint i = 0; i < size; ++i)
+                product += z[i] / size;
+        }
+        else
+        {
+            product = z[previous_index];
+        }
+
+        if (abs(z[index]) <= product)
+            break;
+
+        fill(x.begin(), x.end(), 0.0);
+        x[index] = 1.0;
+        previous_index = index;
+    }
+
+    if (size < 2)
+        return estimate;
+
+    // the alternating test vector guards against the rare matrices that mislead the iteration
+    for (GLuint i = 0; i < size; ++i)
+        x[i] = (i % 2 ? -1.0 : 1.0) * (1.0 + (GLdouble)i / (size - 1));
+
+    solve(x);
+
+    GLdouble alternative = 0.0;
+    for (GLuint i = 0; i < size; ++i)
+        alternative += abs(x[i]);
+    alternative *= 2.0 / (3.0 * size);
+
+    return max(estimate, alternative);
+}
+
+GLdouble RealSquareMatrix::_estimateInverseOneNorm() const
+{
+    return EstimateInverseOneNorm(
+            _row_count,
+            [this](vector<GLdouble>& x) { _solve(x); },
+            [this](vector<GLdouble>& x) { _solveTransposed(x); });
+}
+
 } // namespace cagd
@@ -1,18 +1,78 @@
 #pragma once
 
 #include <GL/glew.h>
+#include <algorithm>
 #include <limits>
 #include <cmath>
+#include <functional>
+#include "DCoordinates3.h"
 #include "Matrices.h"
 
 namespace cagd
 {
+    // Hager's estimate of the 1-norm of A^{-1} (as refined by Higham) for a square matrix A of the
+    // given size that has already been factorized: the callbacks overwrite their argument x by
+    // A^{-1} x and A^{-T} x, respectively, and they are called only a few times; it serves the
+    // condition number estimates of the LU and Cholesky decompositions
+    GLdouble EstimateInverseOneNorm(
+            GLuint size,
+            const std::function<GLvoid(std::vector<GLdouble>&)>& solve,
+            const std::function<GLvoid(std::vector<GLdouble>&)>& solve_transposed);
+
     class RealSquareMatrix: public Matrix<GLdouble>
     {
     private:
+        // the LU decomposition proceeds in panels of LU_BLOCK_SIZE columns, the trailing updates
+        // sweep the columns in tiles of LU_TILE_SIZE elements and are distributed among OpenMP
+        // threads if the trailing submatrix has at least LU_PARALLEL_SIZE rows
+        static const GLuint LU_BLOCK_SIZE    = 64;
+        static const GLuint LU_TILE_SIZE     = 512;
+        static const GLuint LU_PARALLEL_SIZE = 256;
+
+        // if the nonzero elements of the matrix lie in a band of width w, such that
+        // LU_BAND_RATIO * w <= size, the banded elimination is used, that needs O(size w^2)
+        // operations and produces factors with the same band structure
+        static const GLuint LU_BAND_RATIO = 4;
+
+        // the batched substitutions process the right-hand sides in blocks whose component planes
+        // consist of at most SOLVE_BLOCK_ELEMENT_COUNT doubles, but a block contains at least
+        // SOLVE_MINIMAL_BLOCK_SIZE right-hand sides (if there are so many)
+        static const GLuint SOLVE_BLOCK_ELEMENT_COUNT = 32768;
+        static const GLuint SOLVE_MINIMAL_BLOCK_SIZE  = 64;
+        static const GLuint SOLVE_TILE_SIZE           = 16;
+
         GLboolean           _lu_decomposition_is_done;
+        GLdouble            _condition_number;
         std::vector<GLuint> _row_permutation;
 
+        // lower and upper bandwidths detected by the last decomposition (size - 1 in case of the
+        // dense elimination), the nonzero elements of U lie in the columns i,..., i + lower + upper
+        GLuint              _lower_bandwidth, _upper_bandwidth;
+
+        // first stored multiplier of each row of L, the multipliers are interchanged together
+        // with their rows
+        std::vector<GLuint> _lower_begin;
+
+        // one past the last (possibly) nonzero column of the i-th row of U
+        GLuint _upperEnd(GLuint i) const;
+
+        // elimination restricted to the band, the nonzeros of the matrix must lie in the band
+        GLvoid _performBandedLUDecomposition(std::vector<GLdouble>& implicit_scaling_of_each_row);
+
+        // substitutions with the stored factors, used by the condition number estimate
+        GLvoid _solve(std::vector<GLdouble>& x) const;
+        GLvoid _solveTransposed(std::vector<GLdouble>& x) const;
+        GLdouble _estimateInverseOneNorm() const;
+
+        // tiled batched forward and back substitution of a block of count right-hand sides: planes
+        // stores component_count planes, the element (i, k) of plane c is located at the position
+        // (c * size + i) * stride + k, i.e., the updates of a row are contiguous over the
+        // right-hand sides and vectorize
+        GLvoid _solveComponentPlanes(GLuint component_count, GLuint count, GLuint stride, GLdouble *planes) const;
+
+        template <class T>
+        GLboolean _solveBatched(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns, GLuint component_count) const;
+
     public:
         // destructor
         ~RealSquareMatrix();
@@ -26,13 +86,22 @@ namespace cagd
         // assignment operator
         RealSquareMatrix& operator =(const RealSquareMatrix& rhs);
 
+        // move constructor and move assignment operator
+        RealSquareMatrix(RealSquareMatrix&& m) noexcept;
+        RealSquareMatrix& operator =(RealSquareMatrix&& rhs) noexcept;
+
         // square matrices have the same number of rows and columns!
         GLboolean ResizeRows(GLuint row_count);
         GLboolean ResizeColumns(GLuint row_count);
 
-        // tries to determine the LU decomposition of this square matrix
+        // tries to determine the LU decomposition of this square matrix (with scaled partial
+        // pivoting), and estimates the 1-norm condition number of the matrix
         GLboolean PerformLUDecomposition();
 
+        // estimate of ||A||_1 ||A^{-1}||_1 determined by the last LU decomposition, it is
+        // infinite if the decomposition has not been performed yet
+        GLdouble GetConditionNumberEstimate() const;
+
         // Solves linear systems of type A * x = b, where A is a regular square matrix,
         // while b and x are row or column matrices with elements of type T.
         // Here matrix A corresponds to *this.
@@ -40,8 +109,28 @@ namespace cagd
         // or any other type which has similar mathematical operators.
         template <class T>
         GLboolean SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
+
+        // batched solvers of the most common right-hand side types, every right-hand side is
+        // substituted at the same time; b and x may be the same matrix
+        GLboolean SolveLinearSystem(const Matrix<GLdouble>& b, Matrix<GLdouble>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
+        GLboolean SolveLinearSystem(const Matrix<DCoordinate3>& b, Matrix<DCoordinate3>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
+
+        // the same solvers for already decomposed (e.g., shared and read-only) matrices, they fail
+        // if the LU decomposition has not been performed yet
+        GLboolean SolveLinearSystem(const Matrix<GLdouble>& b, Matrix<GLdouble>& x, GLboolean represent_solutions_as_columns = GL_TRUE) const;
+        GLboolean SolveLinearSystem(const Matrix<DCoordinate3>& b, Matrix<DCoordinate3>& x, GLboolean represent_solutions_as_columns = GL_TRUE) const;
+
+        GLboolean IsLUDecompositionDone() const;
+
+        // decides whether the last decomposition exploited the band structure of the matrix
+        GLboolean IsBanded() const;
     };
 
+    inline GLuint RealSquareMatrix::_upperEnd(GLuint i) const
+    {
+        return (GLuint)std::min<unsigned long long>(_row_count, (unsigned long long)i + _lower_bandwidth + _upper_bandwidth + 1);
+    }
+
     template <class T>
     GLboolean RealSquareMatrix::SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns)
     {
@@ -55,31 +144,37 @@ namespace cagd
             if ((GLint)b.GetRowCount() != size)
                     return GL_FALSE;
 
-            x = b;
+            if (&x != &b)
+                x = b;
 
-            for (GLuint k = 0; k < b.GetColumnCount(); ++k)
+            for (GLuint k = 0; k < x.GetColumnCount(); ++k)
             {
+                // the k-th column of x is accessed through a strided view
+                MatrixSpan<T> xk = x.GetColumnSpan(k);
+
                 GLint ii = 0;
                 for (GLint i = 0; i < size; ++i)
                 {
+                    const GLdouble *lu_row = &_data[i * size];
                     GLuint ip = _row_permutation[i];
-                    T sum = x(ip, k);
-                    x(ip, k) = x(i, k);
+                    T sum = xk[ip];
+                    xk[ip] = xk[i];
                     if (ii != 0)
-                        for (GLint j = ii - 1; j < i; ++j)
-                            sum -= _data[i][j] * x(j, k);
+                        for (GLint j = std::max(ii - 1, (GLint)_lower_begin[i]); j < i; ++j)
+                            sum -= lu_row[j] * xk[j];
                     else
                         if (sum != 0.0)
                             ii = i + 1;
-                    x(i, k) = sum;
+                    xk[i] = sum;
                 }
 
                 for (GLint i = size - 1; i >= 0; --i)
                 {
-                    T sum = x(i, k);
-                    for (GLint j = i + 1; j < size; ++j)
-                        sum -= _data[i][j] * x(j, k);
-                    x(i, k) = sum /= _data[i][i];
+                    const GLdouble *lu_row = &_data[i * size];
+                    T sum = xk[i];
+                    for (GLint j = i + 1; j < (GLint)_upperEnd(i); ++j)
+                        sum -= lu_row[j] * xk[j];
+                    xk[i] = sum /= lu_row[i];
                 }
             }
         }
@@ -89,31 +184,37 @@ namespace cagd
             if ((GLint)b.GetColumnCount() != size)
                 return GL_FALSE;
 
-            x = b;
+            if (&x != &b)
+                x = b;
 
-            for (GLuint k = 0; k < b.GetRowCount(); ++k)
+            for (GLuint k = 0; k < x.GetRowCount(); ++k)
             {
+                // the k-th row of x is contiguous
+                T *xk = x.GetData() + k * x.GetColumnCount();
+
                 GLint ii = 0;
                 for (GLint i = 0; i < size; ++i)
                 {
+                    const GLdouble *lu_row = &_data[i * size];
                     GLuint ip = _row_permutation[i];
-                    T sum = x(k, ip);
-                    x(k, ip) = x(k, i);
+                    T sum = xk[ip];
+                    xk[ip] = xk[i];
                     if (ii != 0)
-                        for (GLint j = ii - 1; j < i; ++j)
-                            sum -= _data[i][j] * x(k, j);
+                        for (GLint j = std::max(ii - 1, (GLint)_lower_begin[i]); j < i; ++j)
+                            sum -= lu_row[j] * xk[j];
                     else
                         if (sum != 0.0)
                             ii = i + 1;
-                    x(k, i) = sum;
+                    xk[i] = sum;
                 }
 
                 for (GLint i = size - 1; i >= 0; --i)
                 {
-                    T sum = x(k, i);
-                    for (GLint j = i + 1; j < size; ++j)
-                        sum -= _data[i][j] * x(k, j);
-                    x(k, i) = sum /= _data[i][i];
+                    const GLdouble *lu_row = &_data[i * size];
+                    T sum = xk[i];
+                    for (GLint j = i + 1; j < (GLint)_upperEnd(i); ++j)
+                        sum -= lu_row[j] * xk[j];
+                    xk[i] = sum /= lu_row[i];
                 }
             }
         }
@@ -1,6 +1,12 @@
 #include "TensorProductSurfaces3.h"
 #include "RealSquareMatrices.h"
+#include "InterpolationPlanCache.h"
+#include "Parallelism.h"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <typeinfo>
 
 using namespace cagd;
 using namespace std;
@@ -18,16 +24,13 @@ TensorProductSurface3::PartialDerivatives::PartialDerivatives(GLuint maximum_ord
 
 GLvoid TensorProductSurface3::PartialDerivatives::LoadNullVectors()
 {
-    for (GLuint i = 0; i < _row_count; i++)
-    {
-        for (GLuint j = 0; j <= i; j++)
-        {
-            for (GLuint k = 0; k < 3; k++)
-            {
-                _data[i][j][k] = 0;
-            }
-        }
-    }
+    Fill(DCoordinate3());
+}
+
+GLvoid TensorProductSurface3::PartialDerivatives::Reset(GLuint maximum_order_of_partial_derivatives)
+{
+    ResizeRows(maximum_order_of_partial_derivatives + 1);
+    Fill(DCoordinate3());
 }
 
 // //////////////////////////////////////////
@@ -41,6 +44,7 @@ TensorProductSurface3::TensorProductSurface3(
         GLuint row_count, GLuint column_count,
         GLboolean u_closed, GLboolean v_closed)
         : _u_closed(u_closed), _v_closed(v_closed)
+        , _vbo_data(0)
         , _u_min(u_min), _u_max(u_max)
         , _v_min(v_min), _v_max(v_max)
         , _data(Matrix<DCoordinate3>(row_count, column_count))
@@ -50,16 +54,21 @@ TensorProductSurface3::TensorProductSurface3(
 // homework: copy constructor
 TensorProductSurface3::TensorProductSurface3(const TensorProductSurface3& surface)
     : _u_closed(surface._u_closed), _v_closed(surface._v_closed)
+    , _vbo_data(0)
     , _u_min(surface._u_min), _u_max(surface._u_max)
     , _v_min(surface._v_min), _v_max(surface._v_max)
     , _data(surface._data)
 {
+    if (surface._vbo_data)
+        UpdateVertexBufferObjectsOfData();
 }
 
 // homework: assignment operator
 TensorProductSurface3& TensorProductSurface3::operator =(const TensorProductSurface3& surface)
 {
     if (&surface != this) {
+        DeleteVertexBufferObjectsOfData();
+
         _u_min = surface._u_min;
         _u_max = surface._u_max;
         _v_min = surface._v_min;
@@ -67,6 +76,40 @@ TensorProductSurface3& TensorProductSurface3::operator =(const TensorProductSurf
         _u_closed = surface._u_closed;
         _v_closed = surface._v_closed;
         _data = surface._data;
+
+        if (surface._vbo_data)
+            UpdateVertexBufferObjectsOfData();
+    }
+    return *this;
+}
+
+// move constructor
+TensorProductSurface3::TensorProductSurface3(TensorProductSurface3&& surface) noexcept
+    : _u_closed(surface._u_closed), _v_closed(surface._v_closed)
+    , _vbo_data(surface._vbo_data)
+    , _u_min(surface._u_min), _u_max(surface._u_max)
+    , _v_min(surface._v_min), _v_max(surface._v_max)
+    , _data(std::move(surface._data))
+{
+    surface._vbo_data = 0;
+}
+
+// move assignment operator
+TensorProductSurface3& TensorProductSurface3::operator =(TensorProductSurface3&& surface) noexcept
+{
+    if (&surface != this) {
+        DeleteVertexBufferObjectsOfData();
+
+        _u_min = surface._u_min;
+        _u_max = surface._u_max;
+        _v_min = surface._v_min;
+        _v_max = surface._v_max;
+        _u_closed = surface._u_closed;
+        _v_closed = surface._v_closed;
+        _vbo_data = surface._vbo_data;
+        _data = std::move(surface._data);
+
+        surface._vbo_data = 0;
     }
     return *this;
 }
@@ -157,6 +200,22 @@ DCoordinate3& TensorProductSurface3::operator ()(GLuint row, GLuint column)
     return _data(row, column);
 }
 
+// the default batch-basis hooks are not implemented
+GLboolean TensorProductSurface3::UBlendingFunctionTable(
+        const GLdouble* u, GLuint count, GLuint maximum_order_of_derivatives,
+        SharedTable& table) const
+{
+    (void)u, (void)count, (void)maximum_order_of_derivatives, (void)table;
+    return GL_FALSE;
+}
+
+GLboolean TensorProductSurface3::VBlendingFunctionTable(
+        const GLdouble* v, GLuint count, GLuint maximum_order_of_derivatives,
+        SharedTable& table) const
+{
+    (void)v, (void)count, (void)maximum_order_of_derivatives, (void)table;
+    return GL_FALSE;
+}
 
 // generates the image (i.e., the approximating triangulated mesh) of the tensor product surface
 TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count, GLuint v_div_point_count, GLenum usage_flag) const
@@ -184,60 +243,119 @@ TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count
     GLfloat sdu = 1.0f / (u_div_point_count - 1);
     GLfloat tdv = 1.0f / (v_div_point_count - 1);
 
-    // for face indexing
-    GLuint current_face = 0;
-
-    // partial derivatives of order 0, 1, 2, and 3
-    PartialDerivatives pd;
+    // separable grid evaluation: the blending function tables are calculated once per grid row and
+    // column, then the products q_s = P * (B_v^{(s)})^T of size (n + 1) x v_div_point_count are formed,
+    // s = 0, 1, thus the partial derivative of order (r, s) at (u_i, v_j) is
+    // sum_{k=0}^{n} B_u^{(r)}(k, i) q_s(k, j)
+    GLuint row_count = _data.GetRowCount();
+    GLuint column_count = _data.GetColumnCount();
 
+    RowMatrix<GLdouble> u_parameters(u_div_point_count), v_parameters(v_div_point_count);
     for (GLuint i = 0; i < u_div_point_count; ++i)
+        u_parameters[i] = min(_u_min + i * du, _u_max);
+    for (GLuint j = 0; j < v_div_point_count; ++j)
+        v_parameters[j] = min(_v_min + j * dv, _v_max);
+
+    SharedTable u_table, v_table;
+    GLboolean separable =
+            UBlendingFunctionTable(u_parameters.GetData(), u_div_point_count, 1, u_table) &&
+            VBlendingFunctionTable(v_parameters.GetData(), v_div_point_count, 1, v_table);
+
+    Matrix<DCoordinate3> q0, q1;
+    if (separable)
     {
-		GLdouble u = min(_u_min + i * du, _u_max);
-		GLfloat  s = min(i * sdu, 1.0f);
-        for (GLuint j = 0; j < v_div_point_count; ++j)
+        q0.ResizeColumns(v_div_point_count);
+        q0.ResizeRows(row_count);
+        q1.ResizeColumns(v_div_point_count);
+        q1.ResizeRows(row_count);
+
+        for (GLuint k = 0; k < row_count; ++k)
         {
-			GLdouble v = min(_v_min + j * dv, _v_max);
-			GLfloat  t = min(j * tdv, 1.0f);
-
-            /*
-                3-2
-                |/|
-                0-1
-            */
-            GLuint index[4];
-
-            index[0] = i * v_div_point_count + j;
-            index[1] = index[0] + 1;
-            index[2] = index[1] + v_div_point_count;
-            index[3] = index[2] - 1;
-
-            // calculating all needed surface data
-            CalculatePartialDerivatives(1, u, v, pd);
-
-            // surface point
-            (*result)._vertex[index[0]] = pd(0, 0);
-
-            // unit surface normal
-            (*result)._normal[index[0]] = pd(1, 0);
-            (*result)._normal[index[0]] ^= pd(1, 1);
-            (*result)._normal[index[0]].normalize();
-
-            // texture coordinates
-            (*result)._tex[index[0]].s() = s;
-            (*result)._tex[index[0]].t() = t;
-
-            // faces
-            if (i < u_div_point_count - 1 && j < v_div_point_count - 1)
+            for (GLuint j = 0; j < v_div_point_count; ++j)
             {
-                (*result)._face[current_face][0] = index[0];
-                (*result)._face[current_face][1] = index[1];
-                (*result)._face[current_face][2] = index[2];
-                ++current_face;
-
-                (*result)._face[current_face][0] = index[0];
-                (*result)._face[current_face][1] = index[2];
-                (*result)._face[current_face][2] = index[3];
-                ++current_face;
+                DCoordinate3 &sum0 = q0(k, j), &sum1 = q1(k, j);
+                for (GLuint l = 0; l < column_count; ++l)
+                {
+                    sum0 += _data(k, l) * (*v_table)(l, j);
+                    sum1 += _data(k, l) * (*v_table)(column_count + l, j);
+                }
+            }
+        }
+    }
+
+    // the grid rows are distributed among the tessellation threads, every thread reuses its own
+    // partial derivatives for all of its samples
+    [[maybe_unused]] GLint thread_count = TessellationThreadCount(vertex_count);
+
+    #pragma omp parallel num_threads(thread_count) if(thread_count > 1)
+    {
+        PartialDerivatives pd(1);
+
+        #pragma omp for schedule(static)
+        for (GLint signed_i = 0; signed_i < (GLint)u_div_point_count; ++signed_i)
+        {
+            GLuint   i = (GLuint)signed_i;
+            GLdouble u = u_parameters[i];
+            GLfloat  s = min(i * sdu, 1.0f);
+            for (GLuint j = 0; j < v_div_point_count; ++j)
+            {
+                GLdouble v = v_parameters[j];
+                GLfloat  t = min(j * tdv, 1.0f);
+
+                /*
+                    3-2
+                    |/|
+                    0-1
+                */
+                GLuint index[4];
+
+                index[0] = i * v_div_point_count + j;
+                index[1] = index[0] + 1;
+                index[2] = index[1] + v_div_point_count;
+                index[3] = index[2] - 1;
+
+                // calculating all needed surface data
+                if (separable)
+                {
+                    pd.Reset(1);
+                    for (GLuint k = 0; k < row_count; ++k)
+                    {
+                        pd(0, 0) += q0(k, j) * (*u_table)(k, i);
+                        pd(1, 0) += q0(k, j) * (*u_table)(row_count + k, i);
+                        pd(1, 1) += q1(k, j) * (*u_table)(k, i);
+                    }
+                }
+                else
+                {
+                    CalculatePartialDerivatives(1, u, v, pd);
+                }
+
+                // surface point
+                (*result)._vertex[index[0]] = pd(0, 0);
+
+                // unit surface normal
+                (*result)._normal[index[0]] = pd(1, 0);
+                (*result)._normal[index[0]] ^= pd(1, 1);
+                (*result)._normal[index[0]].normalize();
+
+                // texture coordinates
+                (*result)._tex[index[0]].s() = s;
+                (*result)._tex[index[0]].t() = t;
+
+                // faces, the face index follows from the grid position
+                if (i < u_div_point_count - 1 && j < v_div_point_count - 1)
+                {
+                    GLuint current_face = 2 * (i * (v_div_point_count - 1) + j);
+
+                    (*result)._face[current_face][0] = index[0];
+                    (*result)._face[current_face][1] = index[1];
+                    (*result)._face[current_face][2] = index[2];
+                    ++current_face;
+
+                    (*result)._face[current_face][0] = index[0];
+                    (*result)._face[current_face][1] = index[2];
+                    (*result)._face[current_face][2] = index[3];
+                }
             }
         }
     }
@@ -246,7 +364,76 @@ TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count
 }
 
 // ensures interpolation, i.e. s(u_i, v_j) = d_{i,j}
+GLboolean TensorProductSurface3::UInterpolationSignature(std::vector<GLdouble>&) const
+{
+    return GL_FALSE;
+}
+
+GLboolean TensorProductSurface3::VInterpolationSignature(std::vector<GLdouble>&) const
+{
+    return GL_FALSE;
+}
+
+// returns the LU decomposed u- or v-directional collocation matrix of the given knots, shareable
+// plans are looked up in (or inserted into) the plan cache, other ones are built privately
+InterpolationPlanCache::Plan TensorProductSurface3::_InterpolationPlan(
+        GLboolean u_direction, const GLdouble* knots, GLuint count) const
+{
+    InterpolationPlanCache::Key key;
+    GLboolean plan_is_shareable = u_direction ? UInterpolationSignature(key.second) :
+                                                VInterpolationSignature(key.second);
+
+    if (plan_is_shareable)
+    {
+        key.first = string(typeid(*this).name()) + (u_direction ? "/u" : "/v");
+        key.second.insert(key.second.end(), knots, knots + count);
+
+        InterpolationPlanCache::Plan plan = InterpolationPlanCache::Find(key);
+        if (plan)
+            return plan;
+    }
+
+    RowMatrix<GLdouble> blending_values;
+    RealSquareMatrix    collocation_matrix(count);
+
+    for (GLuint i = 0; i < count; ++i)
+    {
+        if (!(u_direction ? UBlendingFunctionValues(knots[i], blending_values) :
+                            VBlendingFunctionValues(knots[i], blending_values)))
+            return InterpolationPlanCache::Plan();
+        collocation_matrix.SetRow(i, blending_values);
+    }
+
+    if (!collocation_matrix.PerformLUDecomposition())
+        return InterpolationPlanCache::Plan();
+
+    if (plan_is_shareable)
+        return InterpolationPlanCache::Insert(key, std::move(collocation_matrix));
+
+    return make_shared<const RealSquareMatrix>(std::move(collocation_matrix));
+}
+
 GLboolean TensorProductSurface3::UpdateDataForInterpolation(const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector, Matrix<DCoordinate3>& data_points_to_interpolate)
+{
+    return SolveInterpolationProblem(u_knot_vector, v_knot_vector, data_points_to_interpolate, _data);
+}
+
+GLboolean TensorProductSurface3::SolveInterpolationProblem(
+        const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector,
+        const Matrix<DCoordinate3>& data_points_to_interpolate,
+        Matrix<DCoordinate3>& control_net) const
+{
+    InterpolationPlanCache::Plan u_collocation_matrix, v_collocation_matrix;
+
+    if (!InterpolationPlans(u_knot_vector, v_knot_vector, u_collocation_matrix, v_collocation_matrix))
+        return GL_FALSE;
+
+    return SolveInterpolationProblem(u_collocation_matrix, v_collocation_matrix, data_points_to_interpolate, control_net);
+}
+
+GLboolean TensorProductSurface3::InterpolationPlans(
+        const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector,
+        InterpolationPlanCache::Plan& u_plan, InterpolationPlanCache::Plan& v_plan) const
 {
     GLuint row_count = _data.GetRowCount();
     if (!row_count)
@@ -256,38 +443,39 @@ GLboolean TensorProductSurface3::UpdateDataForInterpolation(const RowMatrix<GLdo
     if (!column_count)
         return GL_FALSE;
 
-    if (u_knot_vector.GetColumnCount() != row_count || v_knot_vector.GetRowCount() != column_count || data_points_to_interpolate.GetRowCount() != row_count || data_points_to_interpolate.GetColumnCount() != column_count)
+    if (u_knot_vector.GetColumnCount() != row_count || v_knot_vector.GetRowCount() != column_count)
         return GL_FALSE;
 
-    // 1: calculate the u-collocation matrix and perfom LU-decomposition on it
-    RowMatrix<GLdouble> u_blending_values;
+    // 1: calculate the u-collocation matrix and perfom LU-decomposition on it (or take it from the
+    //    plan cache if the blending functions in direction u can be identified)
+    u_plan = _InterpolationPlan(GL_TRUE, u_knot_vector.GetData(), row_count);
 
-    RealSquareMatrix u_collocation_matrix(row_count);
+    if (!u_plan)
+        return GL_FALSE;
 
-    for (GLuint i = 0; i < row_count; ++i)
-    {
-        if (!UBlendingFunctionValues(u_knot_vector(i), u_blending_values))
-            return GL_FALSE;
-        u_collocation_matrix.SetRow(i, u_blending_values);
-    }
+    // 2: calculate the v-collocation matrix and perform LU-decomposition on it (or take it from the
+    //    plan cache)
+    v_plan = _InterpolationPlan(GL_FALSE, v_knot_vector.GetData(), column_count);
 
-    if (!u_collocation_matrix.PerformLUDecomposition())
+    if (!v_plan)
         return GL_FALSE;
 
-    // 2: calculate the v-collocation matrix and perform LU-decomposition on it
-    RowMatrix<GLdouble> v_blending_values;
+    return GL_TRUE;
+}
 
-    RealSquareMatrix v_collocation_matrix(column_count);
+GLboolean TensorProductSurface3::SolveInterpolationProblem(
+        const InterpolationPlanCache::Plan& u_collocation_matrix, const InterpolationPlanCache::Plan& v_collocation_matrix,
+        const Matrix<DCoordinate3>& data_points_to_interpolate,
+        Matrix<DCoordinate3>& control_net) const
+{
+    GLuint row_count = _data.GetRowCount();
+    GLuint column_count = _data.GetColumnCount();
 
-    for (GLuint j = 0; j < column_count; ++j)
-    {
-        if (!VBlendingFunctionValues(v_knot_vector(j), v_blending_values))
-            return GL_FALSE;
-        v_collocation_matrix.SetRow(j, v_blending_values);
-    }
+    if (!u_collocation_matrix || !v_collocation_matrix)
+        return GL_FALSE;
 
-    if (!v_collocation_matrix.PerformLUDecomposition())
-            return GL_FALSE;
+    if (u_collocation_matrix->GetRowCount() != row_count || v_collocation_matrix->GetRowCount() != column_count || data_points_to_interpolate.GetRowCount() != row_count || data_points_to_interpolate.GetColumnCount() != column_count)
+        return GL_FALSE;
 
     // 3:   for all fixed j in {0, 1,..., column_count} determine control points
     //
@@ -299,21 +487,459 @@ GLboolean TensorProductSurface3::UpdateDataForInterpolation(const RowMatrix<GLdo
     //
     //      for all i = 0, 1,..., row_count.
     Matrix<DCoordinate3> a(row_count, column_count);
-    if (!u_collocation_matrix.SolveLinearSystem(data_points_to_interpolate, a))
+    if (!u_collocation_matrix->SolveLinearSystem(data_points_to_interpolate, a))
         return GL_FALSE;
 
     // 4:   for all fixed i in {0, 1,..., row_count} determine control point
     //
-    //      _data[i][j], j = 0, 1,..., column_count
+    //      control_net(i, j), j = 0, 1,..., column_count
     //
     //      such that
     //
-    //      sum_{l=0}^{column_count} _data(i, l) G_l(v_j) = a_i(v_j)
+    //      sum_{l=0}^{column_count} control_net(i, l) G_l(v_j) = a_i(v_j)
     //
     //      for all j = 0, 1,..., column_count.
-    if (!v_collocation_matrix.SolveLinearSystem(a, _data, GL_FALSE))
+    if (!v_collocation_matrix->SolveLinearSystem(a, control_net, GL_FALSE))
+        return GL_FALSE;
+
+    return GL_TRUE;
+}
+
+// the samples of a least-squares fit are processed in chunks, the blending functions of a chunk are
+// evaluated by a single call of the batch-basis hooks
+static const GLuint FITTING_CHUNK_SIZE = 256;
+
+GLboolean TensorProductSurface3::_BlendingFunctionValuesOfSamples(
+        const GLdouble* u, const GLdouble* v, GLuint count,
+        SharedTable& u_table, SharedTable& v_table, RowMatrix<GLdouble>& values) const
+{
+    GLuint row_count = _data.GetRowCount();
+    GLuint column_count = _data.GetColumnCount();
+
+    if (!UBlendingFunctionTable(u, count, 0, u_table))
+    {
+        shared_ptr<Matrix<GLdouble> > table = make_shared<Matrix<GLdouble> >(row_count, count);
+
+        for (GLuint k = 0; k < count; ++k)
+        {
+            if (!UBlendingFunctionValues(u[k], values))
+                return GL_FALSE;
+
+            for (GLuint i = 0; i < row_count; ++i)
+                (*table)(i, k) = values[i];
+        }
+
+        u_table = table;
+    }
+
+    if (!VBlendingFunctionTable(v, count, 0, v_table))
+    {
+        shared_ptr<Matrix<GLdouble> > table = make_shared<Matrix<GLdouble> >(column_count, count);
+
+        for (GLuint k = 0; k < count; ++k)
+        {
+            if (!VBlendingFunctionValues(v[k], values))
+                return GL_FALSE;
+
+            for (GLuint j = 0; j < column_count; ++j)
+                (*table)(j, k) = values[j];
+        }
+
+        v_table = table;
+    }
+
+    return GL_TRUE;
+}
+
+// Cholesky decomposition A = L L^T of the symmetric matrix whose lower triangle is given by l, the
+// factor L overwrites l row by row; it fails if A is not numerically positive definite
+static GLboolean PerformCholeskyDecomposition(TriangularMatrix<GLdouble>& l)
+{
+    GLuint    size = l.GetRowCount();
+    GLdouble *data = l.GetData();
+
+    for (GLuint i = 0; i < size; ++i)
+    {
+        GLdouble *row_i = data + (size_t)i * (i + 1) / 2;
+
+        for (GLuint j = 0; j <= i; ++j)
+        {
+            const GLdouble *row_j = data + (size_t)j * (j + 1) / 2;
+
+            GLdouble sum = row_i[j];
+            for (GLuint k = 0; k < j; ++k)
+                sum -= row_i[k] * row_j[k];
+
+            if (j < i)
+                row_i[j] = sum / row_j[j];
+            else if (sum > 0.0)
+                row_i[i] = sqrt(sum);
+            else
+                return GL_FALSE;
+        }
+    }
+
+    return GL_TRUE;
+}
+
+// solves L L^T x = b in place by forward and back substitution
+template <typename T>
+static GLvoid SolveCholeskySystem(const TriangularMatrix<GLdouble>& l, vector<T>& x)
+{
+    GLuint          size = l.GetRowCount();
+    const GLdouble *data = l.GetData();
+
+    for (GLuint i = 0; i < size; ++i)
+    {
+        const GLdouble *row = data + (size_t)i * (i + 1) / 2;
+        T sum = x[i];
+        for (GLuint k = 0; k < i; ++k)
+            sum -= x[k] * row[k];
+        x[i] = sum / row[i];
+    }
+
+    for (GLint i = (GLint)size - 1; i >= 0; --i)
+    {
+        const GLdouble *row = data + (size_t)i * (i + 1) / 2;
+        x[i] /= row[i];
+        for (GLint k = 0; k < i; ++k)
+            x[k] -= x[i] * row[k];
+    }
+}
+
+GLboolean TensorProductSurface3::UpdateDataForLeastSquaresFitting(
+        const vector<GLdouble>& u, const vector<GLdouble>& v, const vector<DCoordinate3>& points,
+        GLdouble smoothing_weight, FittingStatistics* statistics)
+{
+    GLuint row_count = _data.GetRowCount();
+    GLuint column_count = _data.GetColumnCount();
+    GLuint unknown_count = row_count * column_count;
+    GLuint point_count = (GLuint)points.size();
+
+    if (!unknown_count || !point_count || u.size() != point_count || v.size() != point_count || smoothing_weight < 0.0)
+        return GL_FALSE;
+
+    chrono::steady_clock::time_point assembly_start = chrono::steady_clock::now();
+
+    // 1: the lower triangle of the normal matrix B^T B and the right-hand side B^T d, where the k-th
+    //    row of B consists of the products F_i(u_k) G_j(v_k) in the order of the control net;
+    //    every thread accumulates the contributions of its chunks separately
+    TriangularMatrix<GLdouble> normal_matrix(unknown_count);
+    vector<DCoordinate3>       right_hand_side(unknown_count);
+    GLboolean            assembly_is_done = GL_TRUE;
+
+    GLint chunk_count = (GLint)((point_count + FITTING_CHUNK_SIZE - 1) / FITTING_CHUNK_SIZE);
+    GLint thread_count = TessellationThreadCount(point_count);
+
+    #pragma omp parallel num_threads(thread_count) if(thread_count > 1)
+    {
+        TriangularMatrix<GLdouble> local_normal_matrix(unknown_count);
+        vector<DCoordinate3>       local_right_hand_side(unknown_count);
+        vector<GLdouble>           products(unknown_count);
+        SharedTable                u_table, v_table;
+        RowMatrix<GLdouble>        values;
+        GLboolean                  local_assembly_is_done = GL_TRUE;
+
+        #pragma omp for schedule(static)
+        for (GLint chunk = 0; chunk < chunk_count; ++chunk)
+        {
+            if (!local_assembly_is_done)
+                continue;
+
+            GLuint first = chunk * FITTING_CHUNK_SIZE;
+            GLuint count = min(FITTING_CHUNK_SIZE, point_count - first);
+
+            if (!_BlendingFunctionValuesOfSamples(&u[first], &v[first], count, u_table, v_table, values))
+            {
+                local_assembly_is_done = GL_FALSE;
+                continue;
+            }
+
+            for (GLuint k = 0; k < count; ++k)
+            {
+                for (GLuint i = 0; i < row_count; ++i)
+                    for (GLuint j = 0; j < column_count; ++j)
+                        products[i * column_count + j] = (*u_table)(i, k) * (*v_table)(j, k);
+
+                const DCoordinate3 &point = points[first + k];
+
+                // rank-1 update, the blending functions of local support produce many zeros
+                for (GLuint a = 0; a < unknown_count; ++a)
+                {
+                    GLdouble product = products[a];
+                    if (product == 0.0)
+                        continue;
+
+                    GLdouble *row = &local_normal_matrix(a, 0);
+                    for (GLuint c = 0; c <= a; ++c)
+                        row[c] += product * products[c];
+
+                    local_right_hand_side[a] += product * point;
+                }
+            }
+        }
+
+        #pragma omp critical
+        {
+            GLdouble       *sum = normal_matrix.GetData();
+            const GLdouble *local_sum = local_normal_matrix.GetData();
+            for (size_t a = 0; a < (size_t)unknown_count * (unknown_count + 1) / 2; ++a)
+                sum[a] += local_sum[a];
+
+            for (GLuint a = 0; a < unknown_count; ++a)
+                right_hand_side[a] += local_right_hand_side[a];
+
+            assembly_is_done = assembly_is_done && local_assembly_is_done;
+        }
+    }
+
+    if (!assembly_is_done)
         return GL_FALSE;
 
+    chrono::steady_clock::time_point solution_start = chrono::steady_clock::now();
+
+    // 2: the smoothing term adds lambda to the diagonal and lambda times the current control
+    //    points to the right-hand side
+    vector<DCoordinate3> x(unknown_count);
+
+    for (GLuint a = 0; a < unknown_count; ++a)
+    {
+        normal_matrix(a, a) += smoothing_weight;
+        x[a] = right_hand_side[a] + smoothing_weight * _data(a / column_count, a % column_count);
+    }
+
+    // the 1-norm of the symmetric normal matrix is its maximal row sum
+    GLdouble one_norm = 0.0;
+    {
+        vector<GLdouble> row_sums(unknown_count, 0.0);
+        for (GLuint a = 0; a < unknown_count; ++a)
+        {
+            for (GLuint c = 0; c < a; ++c)
+            {
+                GLdouble value = abs(normal_matrix(a, c));
+                row_sums[a] += value;
+                row_sums[c] += value;
+            }
+            row_sums[a] += abs(normal_matrix(a, a));
+        }
+        one_norm = *max_element(row_sums.begin(), row_sums.end());
+    }
+
+    // 3: the normal matrix is symmetric positive semidefinite, thus its Cholesky decomposition is
+    //    determined in the packed lower triangle; samples that do not determine every control point
+    //    lead to a singular system that is rejected either by the decomposition or by the condition
+    //    estimate
+    if (!PerformCholeskyDecomposition(normal_matrix))
+        return GL_FALSE;
+
+    // the normal matrix is symmetric, i.e., A^{-T} = A^{-1}
+    function<GLvoid(vector<GLdouble>&)> solve =
+            [&normal_matrix](vector<GLdouble>& y) { SolveCholeskySystem(normal_matrix, y); };
+
+    GLdouble condition_number = one_norm * EstimateInverseOneNorm(unknown_count, solve, solve);
+    if (!(condition_number * numeric_limits<GLdouble>::epsilon() < 1.0))
+        return GL_FALSE;
+
+    SolveCholeskySystem(normal_matrix, x);
+
+    for (GLuint a = 0; a < unknown_count; ++a)
+        _data(a / column_count, a % column_count) = x[a];
+
+    chrono::steady_clock::time_point solution_end = chrono::steady_clock::now();
+
+    if (!statistics)
+        return GL_TRUE;
+
+    statistics->point_count = point_count;
+    statistics->thread_count = thread_count;
+    statistics->assembly_seconds = chrono::duration<GLdouble>(solution_start - assembly_start).count();
+    statistics->solution_seconds = chrono::duration<GLdouble>(solution_end - solution_start).count();
+    statistics->points_per_second = statistics->assembly_seconds > 0.0 ?
+                                    point_count / statistics->assembly_seconds : 0.0;
+    statistics->condition_number = condition_number;
+
+    // 4: distances between the samples and the fitted surface
+    GLdouble squared_error_sum = 0.0, max_error = 0.0;
+
+    #pragma omp parallel num_threads(thread_count) if(thread_count > 1)
+    {
+        SharedTable         u_table, v_table;
+        RowMatrix<GLdouble> values;
+        GLdouble            local_squared_error_sum = 0.0, local_max_error = 0.0;
+
+        #pragma omp for schedule(static)
+        for (GLint chunk = 0; chunk < chunk_count; ++chunk)
+        {
+            GLuint first = chunk * FITTING_CHUNK_SIZE;
+            GLuint count = min(FITTING_CHUNK_SIZE, point_count - first);
+
+            // the same evaluations succeeded during the assembly
+            _BlendingFunctionValuesOfSamples(&u[first], &v[first], count, u_table, v_table, values);
+
+            for (GLuint k = 0; k < count; ++k)
+            {
+                DCoordinate3 surface_point;
+                for (GLuint i = 0; i < row_count; ++i)
+                {
+                    DCoordinate3 sum;
+                    for (GLuint j = 0; j < column_count; ++j)
+                        sum += _data(i, j) * (*v_table)(j, k);
+                    surface_point += sum * (*u_table)(i, k);
+                }
+
+                GLdouble error = (surface_point - points[first + k]).length();
+                local_squared_error_sum += error * error;
+                local_max_error = max(local_max_error, error);
+            }
+        }
+
+        #pragma omp critical
+        {
+            squared_error_sum += local_squared_error_sum;
+            max_error = max(max_error, local_max_error);
+        }
+    }
+
+    statistics->rms_error = sqrt(squared_error_sum / point_count);
+    statistics->max_error = max_error;
+
+    return GL_TRUE;
+}
+
+GLboolean TensorProductSurface3::UpdateDataForLeastSquaresFitting(
+        const vector<DCoordinate3>& points, GLdouble smoothing_weight, FittingStatistics* statistics)
+{
+    vector<GLdouble> u, v;
+    if (!ParameterizeByBestFitPlane(points, u, v))
+        return GL_FALSE;
+
+    return UpdateDataForLeastSquaresFitting(u, v, points, smoothing_weight, statistics);
+}
+
+// the eigenvalues and unit eigenvectors (the columns of e) of the symmetric 3x3 matrix a, determined
+// by cyclic Jacobi rotations, a is overwritten
+static GLvoid SymmetricEigenDecomposition3(GLdouble a[3][3], GLdouble lambda[3], GLdouble e[3][3])
+{
+    for (GLuint i = 0; i < 3; ++i)
+        for (GLuint j = 0; j < 3; ++j)
+            e[i][j] = (i == j) ? 1.0 : 0.0;
+
+    for (GLuint sweep = 0; sweep < 50; ++sweep)
+    {
+        if (a[0][1] == 0.0 && a[0][2] == 0.0 && a[1][2] == 0.0)
+            break;
+
+        for (GLuint p = 0; p < 2; ++p)
+        {
+            for (GLuint q = p + 1; q < 3; ++q)
+            {
+                if (a[p][q] == 0.0)
+                    continue;
+
+                // the rotation in the (p, q) plane that annihilates a[p][q]
+                GLdouble theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                GLdouble t = (theta >= 0.0 ? 1.0 : -1.0) / (abs(theta) + sqrt(theta * theta + 1.0));
+                GLdouble c = 1.0 / sqrt(t * t + 1.0), s = t * c;
+
+                for (GLuint k = 0; k < 3; ++k)
+                {
+                    GLdouble a_kp = a[k][p], a_kq = a[k][q];
+                    a[k][p] = c * a_kp - s * a_kq;
+                    a[k][q] = s * a_kp + c * a_kq;
+                }
+
+                for (GLuint k = 0; k < 3; ++k)
+                {
+                    GLdouble a_pk = a[p][k], a_qk = a[q][k];
+                    a[p][k] = c * a_pk - s * a_qk;
+                    a[q][k] = s * a_pk + c * a_qk;
+                }
+
+                // the annihilated element is set exactly to zero
+                a[p][q] = a[q][p] = 0.0;
+
+                for (GLuint k = 0; k < 3; ++k)
+                {
+                    GLdouble e_kp = e[k][p], e_kq = e[k][q];
+                    e[k][p] = c * e_kp - s * e_kq;
+                    e[k][q] = s * e_kp + c * e_kq;
+                }
+            }
+        }
+    }
+
+    for (GLuint i = 0; i < 3; ++i)
+        lambda[i] = a[i][i];
+}
+
+GLboolean TensorProductSurface3::ParameterizeByBestFitPlane(
+        const vector<DCoordinate3>& points, vector<GLdouble>& u, vector<GLdouble>& v) const
+{
+    GLuint point_count = (GLuint)points.size();
+    if (point_count < 3)
+        return GL_FALSE;
+
+    DCoordinate3 centroid;
+    for (GLuint k = 0; k < point_count; ++k)
+        centroid += points[k];
+    centroid /= (GLdouble)point_count;
+
+    GLdouble covariance[3][3] = {{0.0}};
+    for (GLuint k = 0; k < point_count; ++k)
+    {
+        DCoordinate3 d = points[k] - centroid;
+        for (GLuint i = 0; i < 3; ++i)
+            for (GLuint j = i; j < 3; ++j)
+                covariance[i][j] += d[i] * d[j];
+    }
+
+    for (GLuint i = 1; i < 3; ++i)
+        for (GLuint j = 0; j < i; ++j)
+            covariance[i][j] = covariance[j][i];
+
+    GLdouble lambda[3], e[3][3];
+    SymmetricEigenDecomposition3(covariance, lambda, e);
+
+    // the eigenvectors of the two largest eigenvalues span the plane, the u-direction is the
+    // direction of the largest extent
+    GLuint order[3] = {0, 1, 2};
+    sort(order, order + 3, [&lambda](GLuint i, GLuint j) { return lambda[i] > lambda[j]; });
+
+    DCoordinate3 u_axis(e[0][order[0]], e[1][order[0]], e[2][order[0]]);
+    DCoordinate3 v_axis(e[0][order[1]], e[1][order[1]], e[2][order[1]]);
+
+    u.resize(point_count);
+    v.resize(point_count);
+
+    GLdouble s_min = numeric_limits<GLdouble>::max(), s_max = -s_min;
+    GLdouble t_min = s_min, t_max = s_max;
+
+    for (GLuint k = 0; k < point_count; ++k)
+    {
+        DCoordinate3 d = points[k] - centroid;
+        u[k] = d * u_axis;
+        v[k] = d * v_axis;
+
+        s_min = min(s_min, u[k]);
+        s_max = max(s_max, u[k]);
+        t_min = min(t_min, v[k]);
+        t_max = max(t_max, v[k]);
+    }
+
+    if (s_max <= s_min || t_max <= t_min)
+        return GL_FALSE;
+
+    // the parameter values are clamped, since the batch-basis hooks may reject values that lie outside
+    // of the definition domain due to rounding errors
+    GLdouble u_scale = (_u_max - _u_min) / (s_max - s_min);
+    GLdouble v_scale = (_v_max - _v_min) / (t_max - t_min);
+
+    for (GLuint k = 0; k < point_count; ++k)
+    {
+        u[k] = min(max(_u_min + (u[k] - s_min) * u_scale, _u_min), _u_max);
+        v[k] = min(max(_v_min + (v[k] - t_min) * v_scale, _v_min), _v_max);
+    }
+
     return GL_TRUE;
 }
 
@@ -441,6 +1067,66 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateUIsoparametricLines
     GLdouble v_step = (_v_max - _v_min) / (iso_line_count - 1);
     GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
 
+    // separable evaluation by means of the batch-basis hooks: the control points of the i-th
+    // isoparametric line are q_k = sum_{l=0}^{m} p_{k,l} G_{m,l}(v_i), k = 0, 1,..., n
+    GLuint row_count = _data.GetRowCount();
+    GLuint column_count = _data.GetColumnCount();
+
+    RowMatrix<GLdouble> u_parameters(div_point_count), v_parameters(iso_line_count);
+    for (GLuint j = 0; j < div_point_count; j++)
+        u_parameters[j] = min(_u_min + j * u_step, _u_max);
+    for (GLuint i = 0; i < iso_line_count; i++)
+        v_parameters[i] = min(_v_min + i * v_step, _v_max);
+
+    SharedTable u_table, v_table;
+    if (UBlendingFunctionTable(u_parameters.GetData(), div_point_count, maximum_order_of_derivatives, u_table) &&
+        VBlendingFunctionTable(v_parameters.GetData(), iso_line_count, 0, v_table))
+    {
+        ColumnMatrix<DCoordinate3> q(row_count);
+
+        for (GLuint i = 0; i < iso_line_count; i++)
+        {
+            (*result)[i] = new GenericCurve3(maximum_order_of_derivatives, div_point_count, usage_flag);
+
+            if (!(*result)[i])
+            {
+                for (GLuint j = 0; j < i; j++)
+                {
+                    delete (*result)[j];
+                }
+                delete result, result = nullptr;
+                return result;
+            }
+
+            for (GLuint k = 0; k < row_count; k++)
+            {
+                q[k] = DCoordinate3();
+                for (GLuint l = 0; l < column_count; l++)
+                {
+                    q[k] += _data(k, l) * (*v_table)(l, i);
+                }
+            }
+
+            for (GLuint j = 0; j < div_point_count; j++)
+            {
+                for (GLuint r = 0; r <= maximum_order_of_derivatives; r++)
+                {
+                    DCoordinate3 &d = (*(*result)[i])(r, j);
+                    for (GLuint k = 0; k < row_count; k++)
+                    {
+                        d += q[k] * (*u_table)(r * row_count + k, j);
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // otherwise the partial derivatives are evaluated point by point, the same derivatives are
+    // reused by every sample
+    PartialDerivatives pd(maximum_order_of_derivatives);
+
     for (GLuint i = 0; i < iso_line_count; i++)
     {
         (*result)[i] = new GenericCurve3(maximum_order_of_derivatives, div_point_count, usage_flag);
@@ -459,7 +1145,6 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateUIsoparametricLines
 
         for (GLuint j = 0; j < div_point_count; j++)
         {
-            PartialDerivatives pd;
             GLdouble u = min(_u_min + j * u_step, _u_max);
 
             if (!CalculatePartialDerivatives(maximum_order_of_derivatives, u, v, pd))
@@ -500,6 +1185,66 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateVIsoparametricLines
     GLdouble u_step = (_u_max - _u_min) / (iso_line_count - 1);
     GLdouble v_step = (_v_max - _v_min) / (div_point_count - 1);
 
+    // separable evaluation by means of the batch-basis hooks: the control points of the i-th
+    // isoparametric line are q_l = sum_{k=0}^{n} p_{k,l} F_{n,k}(u_i), l = 0, 1,..., m
+    GLuint row_count = _data.GetRowCount();
+    GLuint column_count = _data.GetColumnCount();
+
+    RowMatrix<GLdouble> u_parameters(iso_line_count), v_parameters(div_point_count);
+    for (GLuint i = 0; i < iso_line_count; i++)
+        u_parameters[i] = min(_u_min + i * u_step, _u_max);
+    for (GLuint j = 0; j < div_point_count; j++)
+        v_parameters[j] = min(_v_min + j * v_step, _v_max);
+
+    SharedTable u_table, v_table;
+    if (UBlendingFunctionTable(u_parameters.GetData(), iso_line_count, 0, u_table) &&
+        VBlendingFunctionTable(v_parameters.GetData(), div_point_count, maximum_order_of_derivatives, v_table))
+    {
+        ColumnMatrix<DCoordinate3> q(column_count);
+
+        for (GLuint i = 0; i < iso_line_count; i++)
+        {
+            (*result)[i] = new GenericCurve3(maximum_order_of_derivatives, div_point_count, usage_flag);
+
+            if (!(*result)[i])
+            {
+                for (GLuint j = 0; j < i; j++)
+                {
+                    delete (*result)[j];
+                }
+                delete result, result = nullptr;
+                return result;
+            }
+
+            for (GLuint l = 0; l < column_count; l++)
+            {
+                q[l] = DCoordinate3();
+                for (GLuint k = 0; k < row_count; k++)
+                {
+                    q[l] += _data(k, l) * (*u_table)(k, i);
+                }
+            }
+
+            for (GLuint j = 0; j < div_point_count; j++)
+            {
+                for (GLuint r = 0; r <= maximum_order_of_derivatives; r++)
+                {
+                    DCoordinate3 &d = (*(*result)[i])(r, j);
+                    for (GLuint l = 0; l < column_count; l++)
+                    {
+                        d += q[l] * (*v_table)(r * column_count + l, j);
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // otherwise the partial derivatives are evaluated point by point, the same derivatives are
+    // reused by every sample
+    PartialDerivatives pd(maximum_order_of_derivatives);
+
     for (GLuint i = 0; i < iso_line_count; i++)
     {
         (*result)[i] = new GenericCurve3(maximum_order_of_derivatives, div_point_count, usage_flag);
@@ -518,7 +1263,6 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateVIsoparametricLines
 
         for (GLuint j = 0; j < div_point_count; j++)
         {
-            PartialDerivatives pd;
             GLdouble v = min(_v_min + j * v_step, _v_max);
 
             if (!CalculatePartialDerivatives(maximum_order_of_derivatives, u, v, pd))
@@ -5,14 +5,24 @@
 #include <iostream>
 #include "Matrices.h"
 #include "GenericCurves3.h"
+#include "InterpolationPlanCache.h"
 #include "TriangulatedMeshes3.h"
+#include <memory>
 #include <vector>
 
 namespace cagd
 {
+    // thread safety: the const methods are reentrant, i.e., they may be called concurrently by several
+    // threads (also on the same instance) as long as no thread calls a non-const method of that instance;
+    // they write only to their output parameters, while the shared plan and table caches are guarded
+    // by mutexes; derived classes must not break this by keeping mutable scratch members, since batch
+    // operations (e.g., the GenerateImage methods and SOQAHCompositeSurface3::InterpolateAll) rely on it
     class TensorProductSurface3
     {
     public:
+        // read-only blending function table of the batch-basis hooks, it may be shared by a cache
+        typedef std::shared_ptr<const Matrix<GLdouble> > SharedTable;
+
         // a nested class the stores the zeroth and higher order partial derivatives associated with a
         // surface point
         class PartialDerivatives: public TriangularMatrix<DCoordinate3>
@@ -22,6 +32,26 @@ namespace cagd
 
             // homework: initializes all partial derivatives to the origin
             GLvoid LoadNullVectors();
+
+            // changes the maximum order and initializes all partial derivatives to the origin;
+            // the packed storage is reused, thus a single instance can be recycled by every
+            // sample of a tessellation loop without heap traffic
+            GLvoid Reset(GLuint maximum_order_of_partial_derivatives);
+        };
+
+        // summary of a least-squares fit: the throughput is the number of samples per second processed
+        // by the parallel assembly of the normal equations, the errors are the distances between the
+        // samples and the corresponding surface points
+        struct FittingStatistics
+        {
+            GLuint   point_count{0};
+            GLint    thread_count{1};
+            GLdouble assembly_seconds{0.0};
+            GLdouble solution_seconds{0.0};
+            GLdouble points_per_second{0.0};
+            GLdouble condition_number{0.0};
+            GLdouble rms_error{0.0};
+            GLdouble max_error{0.0};
         };
 
 
@@ -32,6 +62,15 @@ namespace cagd
         GLdouble             _v_min, _v_max;       // definition domain in direction v
         Matrix<DCoordinate3> _data;                // the control net (usually stores position vectors)
 
+        // LU decomposed collocation matrix of the given u- or v-directional knots
+        InterpolationPlanCache::Plan _InterpolationPlan(GLboolean u_direction, const GLdouble* knots, GLuint count) const;
+
+        // the element (i, k) of u_table (or (j, k) of v_table) is F_i(u[k]) (or G_j(v[k])), the batch-basis
+        // hooks are preferred, the blending functions are evaluated point by point only if they fail
+        GLboolean _BlendingFunctionValuesOfSamples(
+                const GLdouble* u, const GLdouble* v, GLuint count,
+                SharedTable& u_table, SharedTable& v_table, RowMatrix<GLdouble>& values) const;
+
     public:
         // homework: special constructor
         TensorProductSurface3(
@@ -46,6 +85,11 @@ namespace cagd
         // homework: assignment operator
         TensorProductSurface3& operator =(const TensorProductSurface3& surface);
 
+        // move constructor and move assignment operator: the control net and its vertex buffer
+        // object are taken over without any copy or OpenGL call, the source has an empty control net
+        TensorProductSurface3(TensorProductSurface3&& surface) noexcept;
+        TensorProductSurface3& operator =(TensorProductSurface3&& surface) noexcept;
+
         // homework: set/get the definition domain of the surface
         GLvoid SetUInterval(GLdouble u_min, GLdouble u_max);
         GLvoid SetVInterval(GLdouble v_min, GLdouble v_max);
@@ -75,6 +119,23 @@ namespace cagd
         virtual GLboolean VBlendingFunctionValues(
                 GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const = 0;
 
+        // batch-basis hooks of the separable grid evaluation: for the given array of parameter values the
+        // row r * (n + 1) + i (or r * (m + 1) + j) of the table has to store the r-th order derivative of
+        // $F_{n,i}$ (or $G_{m,j}$) at every parameter value, where r = 0, 1,..., maximum_order_of_derivatives;
+        // the default implementations return GL_FALSE, i.e., the surface is evaluated point by point
+        virtual GLboolean UBlendingFunctionTable(
+                const GLdouble* u, GLuint count, GLuint maximum_order_of_derivatives,
+                SharedTable& table) const;
+
+        virtual GLboolean VBlendingFunctionTable(
+                const GLdouble* v, GLuint count, GLuint maximum_order_of_derivatives,
+                SharedTable& table) const;
+
+        // interpolation-plan hooks, see LinearCombination3::InterpolationSignature; the default
+        // implementations return GL_FALSE, i.e., the collocation matrices are always rebuilt
+        virtual GLboolean UInterpolationSignature(std::vector<GLdouble>& signature) const;
+        virtual GLboolean VInterpolationSignature(std::vector<GLdouble>& signature) const;
+
         // calculates the point and higher order (mixed) partial derivatives of the
         // tensor product surface
         //
@@ -86,7 +147,10 @@ namespace cagd
                 GLuint maximum_order_of_partial_derivatives,
                 GLdouble u, GLdouble v, PartialDerivatives& pd) const = 0;
 
-        // generates a triangulated mesh that approximates the shape of the surface above
+        // generates a triangulated mesh that approximates the shape of the surface above; if both
+        // batch-basis hooks are implemented, the blending functions are evaluated only once per grid
+        // row and column, and the points and partial derivatives are obtained as the products
+        // $B_u^{(r)} \cdot P \cdot \left(B_v^{(s)}\right)^T$ of small dense matrices
         virtual TriangulatedMesh3* GenerateImage(
                 GLuint u_div_point_count, GLuint v_div_point_count,
                 GLenum usage_flag = GL_STATIC_DRAW) const;
@@ -98,6 +162,51 @@ namespace cagd
                 const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector,
                 Matrix<DCoordinate3>& data_points_to_interpolate);
 
+        // reentrant part of the method above: the control net that solves the interpolation problem is
+        // stored by the given matrix instead of _data, which remains unchanged
+        GLboolean SolveInterpolationProblem(
+                const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector,
+                const Matrix<DCoordinate3>& data_points_to_interpolate,
+                Matrix<DCoordinate3>& control_net) const;
+
+        // LU decomposed u- and v-directional collocation matrices of the given knot vectors, they are
+        // taken from the plan cache if the blending functions can be identified
+        GLboolean InterpolationPlans(
+                const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector,
+                InterpolationPlanCache::Plan& u_plan, InterpolationPlanCache::Plan& v_plan) const;
+
+        // variant of the method above that solves the interpolation problem by the given plans, i.e.,
+        // it neither locks the plan cache nor decomposes any matrix
+        GLboolean SolveInterpolationProblem(
+                const InterpolationPlanCache::Plan& u_plan, const InterpolationPlanCache::Plan& v_plan,
+                const Matrix<DCoordinate3>& data_points_to_interpolate,
+                Matrix<DCoordinate3>& control_net) const;
+
+        // least-squares fitting: updates the control net such that
+        //
+        // $\sum_{k} \left\| \mathbf{s}(u_k, v_k) - \mathbf{d}_k \right\|^2 + \lambda \sum_{i,j} \left\| \mathbf{p}_{i,j} - \mathbf{p}^{\prime}_{i,j} \right\|^2$
+        //
+        // is minimal, where $\mathbf{p}^{\prime}_{i,j}$ denotes the current control net and $\lambda \geq 0$ is the
+        // given smoothing weight (it keeps those control points in place that are not determined by the
+        // samples); the normal equations are assembled by the tessellation threads, each of them sums
+        // the contributions of its own samples, thus the result may depend on the number of threads
+        // in the last bits; the method fails if the normal equations are numerically singular
+        GLboolean UpdateDataForLeastSquaresFitting(
+                const std::vector<GLdouble>& u, const std::vector<GLdouble>& v,
+                const std::vector<DCoordinate3>& points,
+                GLdouble smoothing_weight = 0.0, FittingStatistics* statistics = nullptr);
+
+        // the same for samples without parameter values, that are parameterized by the method below
+        GLboolean UpdateDataForLeastSquaresFitting(
+                const std::vector<DCoordinate3>& points,
+                GLdouble smoothing_weight = 0.0, FittingStatistics* statistics = nullptr);
+
+        // parameterizes the points by their orthogonal projections onto the least-squares plane of the
+        // cloud, the bounding rectangle of the projections is mapped onto the definition domain
+        GLboolean ParameterizeByBestFitPlane(
+                const std::vector<DCoordinate3>& points,
+                std::vector<GLdouble>& u, std::vector<GLdouble>& v) const;
+
         // homework: VBO handling methods
         virtual GLvoid    DeleteVertexBufferObjectsOfData();
         virtual GLboolean RenderData(GLenum render_mode = GL_LINE_STRIP) const;
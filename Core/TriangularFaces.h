@@ -75,13 +75,21 @@ namespace cagd
         return lhs;
     }
 
-    // input from stream
+    // input from stream: a face consists of exactly three nodes, the indices of larger polygons are
+    // consumed, but the stream fails (polygons are triangulated by TriangulatedMesh3::LoadFromOFF)
     inline std::istream& operator >>(std::istream& lhs, TriangularFace& rhs)
     {
         GLuint nodeCount;
         lhs >> nodeCount;
-        for (GLuint i = 0; i < nodeCount; ++i)
-            lhs >> rhs[i];
+        for (GLuint i = 0; i < nodeCount && lhs; ++i)
+        {
+            GLuint node;
+            lhs >> node;
+            if (i < 3)
+                rhs[i] = node;
+        }
+        if (nodeCount != 3)
+            lhs.setstate(std::ios_base::failbit);
         return lhs;
     }
 }
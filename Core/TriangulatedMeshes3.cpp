@@ -1,9 +1,16 @@
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <sys/stat.h>
+#include <sys/types.h>
 #include <fstream>
 #include <limits>
-#include <algorithm>
 #include "TriangulatedMeshes3.h"
+#include "MemoryMappedFiles.h"
+#include "MeshExporters.h"
+#include "Parallelism.h"
 
 using namespace cagd;
 using namespace std;
@@ -11,6 +18,7 @@ using namespace std;
 TriangulatedMesh3::TriangulatedMesh3(GLuint vertex_count, GLuint face_count, GLenum usage_flag):
 	_usage_flag(usage_flag),
 	_vbo_vertices(0), _vbo_normals(0), _vbo_tex_coordinates(0), _vbo_indices(0),
+	_index_type(GL_UNSIGNED_INT),
 	_vertex(vertex_count), _normal(vertex_count), _tex(vertex_count),
 	_face(face_count)
 {
@@ -19,11 +27,13 @@ TriangulatedMesh3::TriangulatedMesh3(GLuint vertex_count, GLuint face_count, GLe
 TriangulatedMesh3::TriangulatedMesh3(const TriangulatedMesh3 &mesh):
         _usage_flag(mesh._usage_flag),
         _vbo_vertices(0), _vbo_normals(0), _vbo_tex_coordinates(0), _vbo_indices(0),
+        _index_type(GL_UNSIGNED_INT),
 		_leftmost_vertex(mesh._leftmost_vertex), _rightmost_vertex(mesh._rightmost_vertex),
         _vertex(mesh._vertex),
         _normal(mesh._normal),
         _tex(mesh._tex),
-        _face(mesh._face)
+        _face(mesh._face),
+        _vertex_face_adjacency(mesh._vertex_face_adjacency)
 {
     if (mesh._vbo_vertices && mesh._vbo_normals && mesh._vbo_tex_coordinates && mesh._vbo_indices)
         UpdateVertexBufferObjects(mesh._usage_flag);
@@ -42,6 +52,7 @@ TriangulatedMesh3& TriangulatedMesh3::operator =(const TriangulatedMesh3& rhs)
         _normal		      = rhs._normal;
         _tex              = rhs._tex;
         _face             = rhs._face;
+        _vertex_face_adjacency = rhs._vertex_face_adjacency;
 
         if (rhs._vbo_vertices && rhs._vbo_normals && rhs._vbo_tex_coordinates && rhs._vbo_indices)
             UpdateVertexBufferObjects(_usage_flag);
@@ -50,6 +61,53 @@ TriangulatedMesh3& TriangulatedMesh3::operator =(const TriangulatedMesh3& rhs)
     return *this;
 }
 
+TriangulatedMesh3::TriangulatedMesh3(TriangulatedMesh3&& mesh) noexcept:
+        _usage_flag(mesh._usage_flag),
+        _vbo_vertices(mesh._vbo_vertices), _vbo_normals(mesh._vbo_normals),
+        _vbo_tex_coordinates(mesh._vbo_tex_coordinates), _vbo_indices(mesh._vbo_indices),
+        _index_type(mesh._index_type),
+        _leftmost_vertex(mesh._leftmost_vertex), _rightmost_vertex(mesh._rightmost_vertex),
+        _vertex(std::move(mesh._vertex)),
+        _normal(std::move(mesh._normal)),
+        _tex(std::move(mesh._tex)),
+        _face(std::move(mesh._face)),
+        _vertex_face_adjacency(std::move(mesh._vertex_face_adjacency))
+{
+    mesh._vbo_vertices = mesh._vbo_normals = mesh._vbo_tex_coordinates = mesh._vbo_indices = 0;
+}
+
+TriangulatedMesh3& TriangulatedMesh3::operator =(TriangulatedMesh3&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        DeleteVertexBufferObjects();
+
+        _usage_flag          = rhs._usage_flag;
+        _vbo_vertices        = rhs._vbo_vertices;
+        _vbo_normals         = rhs._vbo_normals;
+        _vbo_tex_coordinates = rhs._vbo_tex_coordinates;
+        _vbo_indices         = rhs._vbo_indices;
+        _index_type          = rhs._index_type;
+        _leftmost_vertex     = rhs._leftmost_vertex;
+        _rightmost_vertex    = rhs._rightmost_vertex;
+
+        _vertex.swap(rhs._vertex);
+        _normal.swap(rhs._normal);
+        _tex.swap(rhs._tex);
+        _face.swap(rhs._face);
+        std::swap(_vertex_face_adjacency, rhs._vertex_face_adjacency);
+
+        rhs._vbo_vertices = rhs._vbo_normals = rhs._vbo_tex_coordinates = rhs._vbo_indices = 0;
+        rhs._vertex.clear();
+        rhs._normal.clear();
+        rhs._tex.clear();
+        rhs._face.clear();
+        rhs._vertex_face_adjacency.Clear();
+    }
+
+    return *this;
+}
+
 GLvoid TriangulatedMesh3::DeleteVertexBufferObjects()
 {
     if (_vbo_vertices)
@@ -110,7 +168,7 @@ GLboolean TriangulatedMesh3::Render(GLenum render_mode) const
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo_indices);
 
         // render primitives
-        glDrawElements(render_mode, 3 * (GLsizei)_face.size(), GL_UNSIGNED_INT, (const GLvoid *)0);
+        glDrawElements(render_mode, 3 * (GLsizei)_face.size(), _index_type, (const GLvoid *)0);
 
 
     // disable individual client-side capabilities
@@ -226,6 +284,7 @@ GLboolean TriangulatedMesh3::UpdateVertexBufferObjects(GLenum usage_flag)
     
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo_indices);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_byte_size, 0, _usage_flag);
+    _index_type = GL_UNSIGNED_INT;
     GLuint *element = (GLuint*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
 
     for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit)
@@ -262,121 +321,988 @@ GLboolean TriangulatedMesh3::UpdateVertexBufferObjects(GLenum usage_flag)
     return GL_TRUE;
 }
 
-GLboolean TriangulatedMesh3::LoadFromOFF(
-        const string &file_name, GLboolean translate_and_scale_to_unit_cube)
+// the body of an OFF file is split at line boundaries into chunks of about this many bytes, the
+// chunks are parsed in parallel
+static const size_t OFF_CHUNK_SIZE = 1 << 20;
+
+static inline GLboolean IsBlank(char c)
 {
-    fstream f(file_name.c_str(), ios_base::in);
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// skips the blanks of a line
+static inline const char* SkipBlanks(const char* p, const char* end)
+{
+    while (p < end && IsBlank(*p))
+        ++p;
+    return p;
+}
 
-    if (!f || !f.good())
+// skips white spaces, line breaks and comment lines
+static inline const char* SkipWhiteSpacesAndComments(const char* p, const char* end)
+{
+    for (;;)
+    {
+        while (p < end && (IsBlank(*p) || *p == '\n'))
+            ++p;
+
+        if (p == end || *p != '#')
+            return p;
+
+        const char *line_end = (const char*)memchr(p, '\n', end - p);
+        p = line_end ? line_end : end;
+    }
+}
+
+// the line [p, end) stores data, if it is neither empty nor a comment
+static inline GLboolean IsDataLine(const char* p, const char* end)
+{
+    p = SkipBlanks(p, end);
+    return p < end && *p != '#';
+}
+
+// end of the line that starts at the given position
+static inline const char* FindLineEnd(const char* line, const char* end)
+{
+    const char *line_end = (const char*)memchr(line, '\n', end - line);
+    return line_end ? line_end : end;
+}
+
+// splits the polygon of the given vertex indices into n - 2 triangles of the same orientation: convex
+// polygons are split into a fan, while the other ones are clipped ear by ear in their projection onto
+// the coordinate plane that is the most parallel to the polygon; if a degenerate polygon has no ear,
+// the first corner is clipped anyway
+static GLvoid TriangulatePolygon(const vector<DCoordinate3>& vertex, const vector<GLuint>& polygon,
+                                 vector<GLuint>& remaining, TriangularFace* faces)
+{
+    GLuint n = (GLuint)polygon.size();
+
+    // the sum of the cross products of consecutive vertices is parallel to the normal of the polygon
+    DCoordinate3 normal;
+    for (GLuint i = 0; i < n; ++i)
+        normal += vertex[polygon[i]] ^ vertex[polygon[(i + 1) % n]];
+
+    GLboolean is_convex = GL_TRUE;
+    for (GLuint i = 0; i < n && is_convex; ++i)
+    {
+        const DCoordinate3 &a = vertex[polygon[i]], &b = vertex[polygon[(i + 1) % n]], &c = vertex[polygon[(i + 2) % n]];
+        is_convex = ((b - a) ^ (c - b)) * normal >= 0.0;
+    }
+
+    if (is_convex)
+    {
+        for (GLuint i = 1; i + 1 < n; ++i)
+        {
+            (*faces)[0] = polygon[0];
+            (*faces)[1] = polygon[i];
+            (*faces)[2] = polygon[i + 1];
+            ++faces;
+        }
+        return;
+    }
+
+    // the projection drops the coordinate k of the largest normal component, then the 2D cross
+    // product of the remaining cyclic coordinates equals the k-th component of the 3D one
+    GLuint k = 0;
+    for (GLuint i = 1; i < 3; ++i)
+        if (fabs(normal[i]) > fabs(normal[k]))
+            k = i;
+
+    GLuint   x = (k + 1) % 3, y = (k + 2) % 3;
+    GLdouble orientation = normal[k] < 0.0 ? -1.0 : 1.0;
+
+    remaining.assign(polygon.begin(), polygon.end());
+
+    while (remaining.size() > 3)
+    {
+        GLuint m = (GLuint)remaining.size(), ear = 0;
+        GLboolean ear_found = GL_FALSE;
+
+        for (GLuint i = 0; i < m && !ear_found; ++i)
+        {
+            const DCoordinate3 &a = vertex[remaining[(i + m - 1) % m]], &b = vertex[remaining[i]], &c = vertex[remaining[(i + 1) % m]];
+
+            GLdouble area = orientation * ((b[x] - a[x]) * (c[y] - a[y]) - (b[y] - a[y]) * (c[x] - a[x]));
+            if (area <= 0.0)
+                continue;
+
+            // an ear contains no other corner of the remaining polygon
+            ear_found = GL_TRUE;
+            for (GLuint j = 0; j < m && ear_found; ++j)
+            {
+                const DCoordinate3 &q = vertex[remaining[j]];
+                if (j == i || j == (i + 1) % m || j == (i + m - 1) % m ||
+                    remaining[j] == remaining[i] || remaining[j] == remaining[(i + 1) % m] ||
+                    remaining[j] == remaining[(i + m - 1) % m])
+                    continue;
+
+                ear_found = !(orientation * ((b[x] - a[x]) * (q[y] - a[y]) - (b[y] - a[y]) * (q[x] - a[x])) >= 0.0 &&
+                              orientation * ((c[x] - b[x]) * (q[y] - b[y]) - (c[y] - b[y]) * (q[x] - b[x])) >= 0.0 &&
+                              orientation * ((a[x] - c[x]) * (q[y] - c[y]) - (a[y] - c[y]) * (q[x] - c[x])) >= 0.0);
+            }
+
+            if (ear_found)
+                ear = i;
+        }
+
+        (*faces)[0] = remaining[(ear + m - 1) % m];
+        (*faces)[1] = remaining[ear];
+        (*faces)[2] = remaining[(ear + 1) % m];
+        ++faces;
+
+        remaining.erase(remaining.begin() + ear);
+    }
+
+    (*faces)[0] = remaining[0];
+    (*faces)[1] = remaining[1];
+    (*faces)[2] = remaining[2];
+}
+
+// parses the next number of a line; the parsers of <charconv> are locale-independent and convert exactly
+// as the stream operators do, but they neither skip white spaces nor accept a leading plus sign
+template <typename T>
+static inline GLboolean ParseNumber(const char*& p, const char* end, T& value)
+{
+    p = SkipBlanks(p, end);
+    if (p < end && *p == '+')
+        ++p;
+
+    from_chars_result result = from_chars(p, end, value);
+    if (result.ec != errc())
         return GL_FALSE;
 
-    // loading the header
-    string header;
+    p = result.ptr;
+    return GL_TRUE;
+}
 
-    f >> header;
+// parses the next number of the body: unlike the function above, it also skips line breaks and comment
+// lines, i.e., it reads the numbers in the same way as the stream operators of the former loader did
+template <typename T>
+static inline GLboolean ParseNextNumber(const char*& p, const char* end, T& value)
+{
+    p = SkipWhiteSpacesAndComments(p, end);
+    return ParseNumber(p, end, value);
+}
+
+// the fast path of LoadFromOFF: if every vertex and face of the body [body, end) is stored in a separate
+// line, the body is split at line boundaries into chunks that are parsed in parallel; the function fails
+// if the body does not follow this layout (or it is invalid), in that case the body has to be parsed by
+// the sequential function below
+static GLboolean ParseOFFBodyByLines(
+        const char* body, const char* end, GLuint vertex_count, GLuint face_count,
+        vector<DCoordinate3>& vertex, vector<TriangularFace>& face,
+        DCoordinate3& leftmost_vertex, DCoordinate3& rightmost_vertex)
+{
+    // splitting the body into chunks of complete lines
+    vector<const char*> chunk_begin(1, body);
+    while (chunk_begin.back() < end)
+    {
+        const char *q = chunk_begin.back() + min(OFF_CHUNK_SIZE, (size_t)(end - chunk_begin.back()));
+        if (q < end)
+            q = FindLineEnd(q, end) + 1;
+        chunk_begin.push_back(min(q, end));
+    }
 
-    if (header != "OFF")
+    GLint chunk_count = (GLint)chunk_begin.size() - 1;
+    [[maybe_unused]] GLint thread_count = TessellationThreadCount(vertex_count + face_count);
+    GLuint line_count = vertex_count + face_count;
+
+    // 1: counting the data lines of the chunks, their prefix sums are the indices of the first
+    //    vertex or face of the chunks
+    vector<GLuint> first_line(chunk_count + 1, 0);
+
+    #pragma omp parallel for schedule(dynamic) num_threads(thread_count) if(thread_count > 1)
+    for (GLint c = 0; c < chunk_count; ++c)
+    {
+        GLuint count = 0;
+        for (const char *line = chunk_begin[c], *line_end; line < chunk_begin[c + 1]; line = line_end + 1)
+        {
+            line_end = FindLineEnd(line, chunk_begin[c + 1]);
+            if (IsDataLine(line, line_end))
+                ++count;
+        }
+        first_line[c + 1] = count;
+    }
+
+    for (GLint c = 0; c < chunk_count; ++c)
+        first_line[c + 1] += first_line[c];
+
+    if (first_line[chunk_count] < line_count)
         return GL_FALSE;
 
-    // loading number of vertices, faces, and edges
-    GLuint vertex_count, face_count, edge_count;
+    // 2: the faces are polygons of at least three corners, counting the triangles of the chunks by
+    //    the leading node counts of the faces, hence the array of triangles is allocated only once
+    vector<GLuint>    first_triangle(chunk_count + 1, 0);
+    vector<GLboolean> chunk_is_valid(chunk_count, GL_TRUE);
 
-    f >> vertex_count >> face_count >> edge_count;
+    #pragma omp parallel for schedule(dynamic) num_threads(thread_count) if(thread_count > 1)
+    for (GLint c = 0; c < chunk_count; ++c)
+    {
+        if (first_line[c + 1] <= vertex_count || first_line[c] >= line_count)
+            continue;
 
-    // allocating memory for vertices, unit normal vectors, texture coordinates, and faces
-    _vertex.resize(vertex_count);
-    _normal.resize(vertex_count);
-    _tex.resize(vertex_count);
-    _face.resize(face_count);
+        GLuint index = first_line[c], count = 0;
+        for (const char *line = chunk_begin[c], *line_end; line < chunk_begin[c + 1] && index < line_count; line = line_end + 1)
+        {
+            line_end = FindLineEnd(line, chunk_begin[c + 1]);
+            if (!IsDataLine(line, line_end))
+                continue;
+
+            if (index >= vertex_count)
+            {
+                const char *q = line;
+                GLuint node_count;
+
+                if (!ParseNumber(q, line_end, node_count) || node_count < 3)
+                {
+                    chunk_is_valid[c] = GL_FALSE;
+                    break;
+                }
+
+                count += node_count - 2;
+            }
+
+            ++index;
+        }
+        first_triangle[c + 1] = count;
+    }
+
+    for (GLint c = 0; c < chunk_count; ++c)
+    {
+        if (!chunk_is_valid[c])
+            return GL_FALSE;
+
+        first_triangle[c + 1] += first_triangle[c];
+    }
 
-    // initializing the leftmost and rightmost corners of the bounding box
-    _leftmost_vertex.x() = _leftmost_vertex.y() = _leftmost_vertex.z() = numeric_limits<GLdouble>::max();
-    _rightmost_vertex.x() = _rightmost_vertex.y() = _rightmost_vertex.z() = -numeric_limits<GLdouble>::max();
+    vertex.resize(vertex_count);
+    face.resize(first_triangle[chunk_count]);
+
+    // 3: loading vertices, every chunk corrects its own bounding box; a line that ends early or stores
+    //    further data breaks the layout
+    vector<DCoordinate3> chunk_leftmost(chunk_count), chunk_rightmost(chunk_count);
+
+    #pragma omp parallel for schedule(dynamic) num_threads(thread_count) if(thread_count > 1)
+    for (GLint c = 0; c < chunk_count; ++c)
+    {
+        DCoordinate3 &leftmost = chunk_leftmost[c], &rightmost = chunk_rightmost[c];
+        leftmost.x() = leftmost.y() = leftmost.z() = numeric_limits<GLdouble>::max();
+        rightmost.x() = rightmost.y() = rightmost.z() = -numeric_limits<GLdouble>::max();
+
+        GLuint index = first_line[c];
+        for (const char *line = chunk_begin[c], *line_end; line < chunk_begin[c + 1] && index < vertex_count; line = line_end + 1)
+        {
+            line_end = FindLineEnd(line, chunk_begin[c + 1]);
+            if (!IsDataLine(line, line_end))
+                continue;
+
+            const char   *q = line;
+            DCoordinate3 &v = vertex[index++];
+
+            if (!ParseNumber(q, line_end, v.x()) || !ParseNumber(q, line_end, v.y()) ||
+                !ParseNumber(q, line_end, v.z()) || IsDataLine(q, line_end))
+            {
+                chunk_is_valid[c] = GL_FALSE;
+                break;
+            }
+
+            if (v.x() < leftmost.x())
+                leftmost.x() = v.x();
+            if (v.y() < leftmost.y())
+                leftmost.y() = v.y();
+            if (v.z() < leftmost.z())
+                leftmost.z() = v.z();
+
+            if (v.x() > rightmost.x())
+                rightmost.x() = v.x();
+            if (v.y() > rightmost.y())
+                rightmost.y() = v.y();
+            if (v.z() > rightmost.z())
+                rightmost.z() = v.z();
+        }
+    }
+
+    for (GLint c = 0; c < chunk_count; ++c)
+        if (!chunk_is_valid[c])
+            return GL_FALSE;
+
+    // 4: loading and triangulating faces, the triangulation of non-convex polygons needs the
+    //    positions of the vertices, therefore it follows the previous step
+    #pragma omp parallel num_threads(thread_count) if(thread_count > 1)
+    {
+        vector<GLuint> polygon, remaining;
+
+        #pragma omp for schedule(dynamic)
+        for (GLint c = 0; c < chunk_count; ++c)
+        {
+            if (first_line[c + 1] <= vertex_count || first_line[c] >= line_count)
+                continue;
+
+            GLuint index = first_line[c];
+            TriangularFace *faces = face.data() + first_triangle[c];
+
+            for (const char *line = chunk_begin[c], *line_end; line < chunk_begin[c + 1] && index < line_count; line = line_end + 1)
+            {
+                line_end = FindLineEnd(line, chunk_begin[c + 1]);
+                if (!IsDataLine(line, line_end))
+                    continue;
+
+                if (index++ < vertex_count)
+                    continue;
+
+                const char *q = line;
+                GLuint node_count;
+                ParseNumber(q, line_end, node_count);
+
+                polygon.resize(node_count);
+                GLboolean is_valid = GL_TRUE;
+                for (GLuint i = 0; i < node_count && is_valid; ++i)
+                    is_valid = ParseNumber(q, line_end, polygon[i]) && polygon[i] < vertex_count;
+
+                if (!is_valid || IsDataLine(q, line_end))
+                {
+                    chunk_is_valid[c] = GL_FALSE;
+                    break;
+                }
+
+                if (node_count == 3)
+                {
+                    (*faces)[0] = polygon[0];
+                    (*faces)[1] = polygon[1];
+                    (*faces)[2] = polygon[2];
+                }
+                else
+                    TriangulatePolygon(vertex, polygon, remaining, faces);
+
+                faces += node_count - 2;
+            }
+        }
+    }
+
+    // initializing the leftmost and rightmost corners of the bounding box, then correcting them by
+    // the boxes of the chunks
+    leftmost_vertex.x() = leftmost_vertex.y() = leftmost_vertex.z() = numeric_limits<GLdouble>::max();
+    rightmost_vertex.x() = rightmost_vertex.y() = rightmost_vertex.z() = -numeric_limits<GLdouble>::max();
+
+    for (GLint c = 0; c < chunk_count; ++c)
+    {
+        if (!chunk_is_valid[c])
+            return GL_FALSE;
+
+        for (GLuint i = 0; i < 3; ++i)
+        {
+            if (chunk_leftmost[c][i] < leftmost_vertex[i])
+                leftmost_vertex[i] = chunk_leftmost[c][i];
+            if (chunk_rightmost[c][i] > rightmost_vertex[i])
+                rightmost_vertex[i] = chunk_rightmost[c][i];
+        }
+    }
+
+    return GL_TRUE;
+}
+
+// the sequential fallback of LoadFromOFF: the vertices and faces of the body are parsed token by token,
+// i.e., a record may be split over several lines and a line may store several records
+static GLboolean ParseOFFBodyByTokens(
+        const char* p, const char* end, GLuint vertex_count, GLuint face_count,
+        vector<DCoordinate3>& vertex, vector<TriangularFace>& face,
+        DCoordinate3& leftmost_vertex, DCoordinate3& rightmost_vertex)
+{
+    vertex.resize(vertex_count);
+    face.clear();
+    face.reserve(face_count);
 
     // loading vertices and correcting the leftmost and rightmost corners of the bounding box
-    for (vector<DCoordinate3>::iterator vit = _vertex.begin(); vit != _vertex.end(); ++vit)
+    leftmost_vertex.x() = leftmost_vertex.y() = leftmost_vertex.z() = numeric_limits<GLdouble>::max();
+    rightmost_vertex.x() = rightmost_vertex.y() = rightmost_vertex.z() = -numeric_limits<GLdouble>::max();
+
+    for (GLuint index = 0; index < vertex_count; ++index)
     {
-        f >> *vit;
+        DCoordinate3 &v = vertex[index];
 
-        if (vit->x() < _leftmost_vertex.x())
-            _leftmost_vertex.x() = vit->x();
-        if (vit->y() < _leftmost_vertex.y())
-            _leftmost_vertex.y() = vit->y();
-        if (vit->z() < _leftmost_vertex.z())
-            _leftmost_vertex.z() = vit->z();
+        for (GLuint i = 0; i < 3; ++i)
+        {
+            if (!ParseNextNumber(p, end, v[i]))
+                return GL_FALSE;
 
-        if (vit->x() > _rightmost_vertex.x())
-            _rightmost_vertex.x() = vit->x();
-        if (vit->y() > _rightmost_vertex.y())
-            _rightmost_vertex.y() = vit->y();
-        if (vit->z() > _rightmost_vertex.z())
-            _rightmost_vertex.z() = vit->z();
+            if (v[i] < leftmost_vertex[i])
+                leftmost_vertex[i] = v[i];
+            if (v[i] > rightmost_vertex[i])
+                rightmost_vertex[i] = v[i];
+        }
     }
 
+    // loading and triangulating faces
+    vector<GLuint> polygon, remaining;
+
+    for (GLuint index = 0; index < face_count; ++index)
+    {
+        GLuint node_count;
+        if (!ParseNextNumber(p, end, node_count) || node_count < 3)
+            return GL_FALSE;
+
+        polygon.resize(node_count);
+        for (GLuint i = 0; i < node_count; ++i)
+            if (!ParseNextNumber(p, end, polygon[i]) || polygon[i] >= vertex_count)
+                return GL_FALSE;
+
+        size_t first = face.size();
+        face.resize(first + node_count - 2);
+
+        if (node_count == 3)
+        {
+            face[first][0] = polygon[0];
+            face[first][1] = polygon[1];
+            face[first][2] = polygon[2];
+        }
+        else
+            TriangulatePolygon(vertex, polygon, remaining, face.data() + first);
+    }
+
+    return GL_TRUE;
+}
+
+GLboolean TriangulatedMesh3::LoadFromOFF(
+        const string &file_name, GLboolean translate_and_scale_to_unit_cube)
+{
+    MemoryMappedFile file;
+
+    if (!file.Open(file_name))
+        return GL_FALSE;
+
+    const char *p = file.GetData(), *end = p + file.GetSize();
+
+    // loading the header
+    p = SkipWhiteSpacesAndComments(p, end);
+
+    if (end - p < 3 || strncmp(p, "OFF", 3) || (end - p > 3 && !IsBlank(p[3]) && p[3] != '\n'))
+        return GL_FALSE;
+
+    p += 3;
+
+    // loading number of vertices, faces, and edges
+    GLuint vertex_count, face_count, edge_count;
+
+    if (!ParseNextNumber(p, end, vertex_count) || !ParseNextNumber(p, end, face_count) ||
+        !ParseNextNumber(p, end, edge_count))
+        return GL_FALSE;
+
+    // the file is parsed into local arrays, thus the mesh remains unchanged if the loading fails;
+    // usually every vertex and face is stored in a separate line, then the body is parsed in parallel,
+    // otherwise (e.g., if the header line or another line stores further records, or if a record is
+    // split over several lines) it is parsed token by token
+    vector<DCoordinate3>   vertex;
+    vector<TriangularFace> face;
+    DCoordinate3           leftmost_vertex, rightmost_vertex;
+
+    const char *header_end = FindLineEnd(p, end);
+
+    if ((IsDataLine(p, header_end) ||
+         !ParseOFFBodyByLines(min(header_end + 1, end), end, vertex_count, face_count,
+                              vertex, face, leftmost_vertex, rightmost_vertex)) &&
+        !ParseOFFBodyByTokens(p, end, vertex_count, face_count,
+                              vertex, face, leftmost_vertex, rightmost_vertex))
+        return GL_FALSE;
+
+    [[maybe_unused]] GLint thread_count = TessellationThreadCount(vertex_count + face_count);
+
     // if we do not want to preserve the original positions and coordinates of vertices
     if (translate_and_scale_to_unit_cube)
     {
-        GLdouble scale = 1.0 / max(_rightmost_vertex.x() - _leftmost_vertex.x(),
-                                   max(_rightmost_vertex.y() - _leftmost_vertex.y(),
-                                       _rightmost_vertex.z() - _leftmost_vertex.z()));
+        GLdouble scale = 1.0 / max(rightmost_vertex.x() - leftmost_vertex.x(),
+                                   max(rightmost_vertex.y() - leftmost_vertex.y(),
+                                       rightmost_vertex.z() - leftmost_vertex.z()));
 
-        DCoordinate3 middle(_leftmost_vertex);
-        middle += _rightmost_vertex;
+        DCoordinate3 middle(leftmost_vertex);
+        middle += rightmost_vertex;
         middle *= 0.5;
-        for (vector<DCoordinate3>::iterator vit = _vertex.begin(); vit != _vertex.end(); ++vit)
+
+        #pragma omp parallel for schedule(static) num_threads(thread_count) if(thread_count > 1)
+        for (GLint i = 0; i < (GLint)vertex_count; ++i)
         {
-            *vit -= middle;
-            *vit *= scale;
+            vertex[i] -= middle;
+            vertex[i] *= scale;
         }
     }
 
-    // loading faces
-    for (vector<TriangularFace>::iterator fit = _face.begin(); fit != _face.end(); ++fit)
-        f >> *fit;
+    // the whole file has been parsed successfully, the new geometry replaces the old one
+    _vertex.swap(vertex);
+    _face.swap(face);
+    _normal.assign(vertex_count, DCoordinate3());
+    _tex.assign(vertex_count, TCoordinate4());
+    _leftmost_vertex = leftmost_vertex;
+    _rightmost_vertex = rightmost_vertex;
+
+    // calculating average unit normal vectors associated with vertices, since every vertex index has
+    // been validated, this step cannot fail
+    if (!UpdateUnitNormalVectors(NormalWeighting::AREA))
+        return GL_FALSE;
 
-    // calculating average unit normal vectors associated with vertices
-    for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit)
+    return GL_TRUE;
+}
+
+// ///////////////////////////////////////////
+// VertexFaceAdjacency class implementation
+// ///////////////////////////////////////////
+
+GLboolean TriangulatedMesh3::VertexFaceAdjacency::Build(GLuint vertex_count, const vector<TriangularFace>& faces)
+{
+    GLint face_count = (GLint)faces.size();
+    [[maybe_unused]] GLint thread_count = TessellationThreadCount(vertex_count + face_count);
+
+    _offset.assign(vertex_count + 1, 0);
+    _face.resize(3 * faces.size());
+
+    // 1: counting the degrees of the vertices
+    GLboolean is_valid = GL_TRUE;
+
+    #pragma omp parallel for schedule(static) num_threads(thread_count) if(thread_count > 1) reduction(&&:is_valid)
+    for (GLint f = 0; f < face_count; ++f)
+    {
+        for (GLuint node = 0; node < 3; ++node)
+        {
+            GLuint vertex = faces[f][node];
+            if (vertex >= vertex_count)
+            {
+                is_valid = GL_FALSE;
+                continue;
+            }
+
+            #pragma omp atomic
+            ++_offset[vertex + 1];
+        }
+    }
+
+    if (!is_valid)
+    {
+        Clear();
+        return GL_FALSE;
+    }
+
+    // 2: the prefix sums of the degrees are the first positions of the incident faces
+    for (GLuint i = 0; i < vertex_count; ++i)
+        _offset[i + 1] += _offset[i];
+
+    // 3: scattering the face indices, the order of the faces of a vertex depends on the threads...
+    vector<GLuint> position(_offset.begin(), _offset.end() - 1);
+
+    #pragma omp parallel for schedule(static) num_threads(thread_count) if(thread_count > 1)
+    for (GLint f = 0; f < face_count; ++f)
+    {
+        for (GLuint node = 0; node < 3; ++node)
+        {
+            GLuint vertex = faces[f][node], p;
+
+            #pragma omp atomic capture
+            p = position[vertex]++;
+
+            _face[p] = (GLuint)f;
+        }
+    }
+
+    // 4: ...hence the short lists are sorted
+    #pragma omp parallel for schedule(static) num_threads(thread_count) if(thread_count > 1)
+    for (GLint i = 0; i < (GLint)vertex_count; ++i)
     {
-        DCoordinate3 n = _vertex[(*fit)[1]];
-        n -= _vertex[(*fit)[0]];
+        sort(_face.begin() + _offset[i], _face.begin() + _offset[i + 1]);
+    }
 
-        DCoordinate3 p = _vertex[(*fit)[2]];
-        p -= _vertex[(*fit)[0]];
+    return GL_TRUE;
+}
+
+GLvoid TriangulatedMesh3::VertexFaceAdjacency::Clear()
+{
+    _offset.clear();
+    _face.clear();
+}
+
+GLuint TriangulatedMesh3::VertexFaceAdjacency::VertexCount() const
+{
+    return _offset.empty() ? 0 : (GLuint)_offset.size() - 1;
+}
+
+GLuint TriangulatedMesh3::VertexFaceAdjacency::Degree(GLuint vertex) const
+{
+    return _offset[vertex + 1] - _offset[vertex];
+}
+
+const GLuint* TriangulatedMesh3::VertexFaceAdjacency::Begin(GLuint vertex) const
+{
+    return _face.data() + _offset[vertex];
+}
+
+const GLuint* TriangulatedMesh3::VertexFaceAdjacency::End(GLuint vertex) const
+{
+    return _face.data() + _offset[vertex + 1];
+}
+
+GLboolean TriangulatedMesh3::UpdateVertexFaceAdjacency()
+{
+    return _vertex_face_adjacency.Build((GLuint)_vertex.size(), _face);
+}
+
+const TriangulatedMesh3::VertexFaceAdjacency& TriangulatedMesh3::GetVertexFaceAdjacency() const
+{
+    return _vertex_face_adjacency;
+}
+
+GLboolean TriangulatedMesh3::UpdateUnitNormalVectors(NormalWeighting weighting, GLboolean update_adjacency)
+{
+    GLuint vertex_count = (GLuint)_vertex.size();
+    GLint  face_count = (GLint)_face.size();
+
+    if (update_adjacency || _vertex_face_adjacency.VertexCount() != vertex_count)
+    {
+        if (!UpdateVertexFaceAdjacency())
+            return GL_FALSE;
+    }
+
+    [[maybe_unused]] GLint thread_count = TessellationThreadCount(vertex_count + face_count);
+
+    // face normals of length twice the area of the faces (the angle weighting needs the unit ones)
+    vector<DCoordinate3> face_normal(face_count);
+
+    #pragma omp parallel for schedule(static) num_threads(thread_count) if(thread_count > 1)
+    for (GLint f = 0; f < face_count; ++f)
+    {
+        DCoordinate3 n = _vertex[_face[f][1]];
+        n -= _vertex[_face[f][0]];
+
+        DCoordinate3 p = _vertex[_face[f][2]];
+        p -= _vertex[_face[f][0]];
 
         n ^= p;
 
-        for (GLint node = 0; node < 3; ++node)
-            _normal[(*fit)[node]] += n;
+        if (weighting != NormalWeighting::AREA)
+            n.normalize();
+
+        face_normal[f] = n;
     }
 
-    for (vector<DCoordinate3>::iterator nit = _normal.begin(); nit != _normal.end(); ++nit)
-        nit->normalize();
+    _normal.resize(vertex_count);
 
-    f.close();
+    #pragma omp parallel for schedule(static) num_threads(thread_count) if(thread_count > 1)
+    for (GLint signed_i = 0; signed_i < (GLint)vertex_count; ++signed_i)
+    {
+        GLuint       i = (GLuint)signed_i;
+        DCoordinate3 normal;
+
+        for (const GLuint *fit = _vertex_face_adjacency.Begin(i); fit != _vertex_face_adjacency.End(i); ++fit)
+        {
+            if (weighting == NormalWeighting::ANGLE)
+            {
+                const TriangularFace &face = _face[*fit];
+                GLuint node = (face[0] == i) ? 0 : ((face[1] == i) ? 1 : 2);
+
+                DCoordinate3 a = _vertex[face[(node + 1) % 3]];
+                a -= _vertex[i];
+
+                DCoordinate3 b = _vertex[face[(node + 2) % 3]];
+                b -= _vertex[i];
+
+                GLdouble length = a.length() * b.length();
+                if (length > 0.0)
+                    normal += face_normal[*fit] * acos(max(-1.0, min(1.0, (a * b) / length)));
+            }
+            else
+                normal += face_normal[*fit];
+        }
+
+        _normal[i] = normal.normalize();
+    }
 
     return GL_TRUE;
 }
 
-GLboolean TriangulatedMesh3::SaveToOFF(const std::string& file_name) const
+// layout of the binary mesh cache: a header followed by the blocks of vertices (3 floats per vertex),
+// unit normal vectors (3 floats per vertex), texture coordinates (4 floats per vertex) and indices
+// (3 uint16 or uint32 values per face); every block starts at a multiple of 16 bytes and has the
+// layout of the corresponding vertex buffer object; the cache is a local artifact of the source file,
+// hence it is stored in the native byte order
+struct MeshCacheHeader
 {
-    fstream f(file_name.c_str(), ios_base::out);
-    
-    if (!f || !f.good())
+    char     magic[8];
+    GLuint   version;
+    GLuint   flags;
+    GLuint64 source_size;
+    GLint64  source_modification_time;
+    GLuint   vertex_count;
+    GLuint   face_count;
+    GLdouble leftmost_vertex[3];
+    GLdouble rightmost_vertex[3];
+    GLuint64 block_offset[4];
+};
+
+static const char   MESH_CACHE_MAGIC[8] = {'C', 'A', 'G', 'D', 'M', 'E', 'S', 'H'};
+static const GLuint MESH_CACHE_VERSION  = 1;
+
+// flags of the cache
+static const GLuint MESH_CACHE_TRANSLATED_AND_SCALED = 1;
+static const GLuint MESH_CACHE_SHORT_INDICES         = 2;
+
+static inline GLuint64 AlignTo16(GLuint64 offset)
+{
+    return (offset + 15) & ~(GLuint64)15;
+}
+
+// size and modification time of a file
+static GLboolean GetFileStamp(const string& file_name, GLuint64& size, GLint64& modification_time)
+{
+#ifdef _WIN32
+    struct _stat64 status;
+    if (_stat64(file_name.c_str(), &status))
+        return GL_FALSE;
+#else
+    struct stat status;
+    if (stat(file_name.c_str(), &status))
+        return GL_FALSE;
+#endif
+
+    size = (GLuint64)status.st_size;
+    modification_time = (GLint64)status.st_mtime;
+
+    return GL_TRUE;
+}
+
+GLboolean TriangulatedMesh3::LoadFromCachedOFF(
+        const string& file_name, GLboolean translate_and_scale_to_unit_cube, GLenum usage_flag,
+        GLboolean* vbo_update_failed)
+{
+    if (vbo_update_failed)
+        *vbo_update_failed = GL_FALSE;
+
+    CacheStamp stamp;
+    if (!GetFileStamp(file_name, stamp.source_size, stamp.source_modification_time))
+        return GL_FALSE;
+
+    stamp.flags = translate_and_scale_to_unit_cube ? MESH_CACHE_TRANSLATED_AND_SCALED : 0;
+
+    string cache_file_name = file_name + ".cache";
+
+    GLboolean vbos_are_updated = GL_FALSE;
+
+    if (!_LoadFromCache(cache_file_name, stamp, usage_flag, vbos_are_updated))
+    {
+        if (!LoadFromOFF(file_name, translate_and_scale_to_unit_cube))
+            return GL_FALSE;
+
+        // a cache that cannot be written (e.g., into a read-only directory) costs only the parsing of
+        // the next load
+        _SaveToCache(cache_file_name, stamp);
+
+        vbos_are_updated = UpdateVertexBufferObjects(usage_flag);
+    }
+
+    if (!vbos_are_updated && vbo_update_failed)
+        *vbo_update_failed = GL_TRUE;
+
+    return vbos_are_updated;
+}
+
+GLboolean TriangulatedMesh3::_LoadFromCache(const string& cache_file_name, const CacheStamp& stamp, GLenum usage_flag,
+                                            GLboolean& vbos_are_updated)
+{
+    vbos_are_updated = GL_FALSE;
+
+    MemoryMappedFile file;
+
+    if (!file.Open(cache_file_name) || file.GetSize() < sizeof(MeshCacheHeader))
         return GL_FALSE;
 
-    // save header to file
-    f << "OFF";
+    MeshCacheHeader header;
+    memcpy(&header, file.GetData(), sizeof(MeshCacheHeader));
+
+    if (memcmp(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC)) ||
+        header.version != MESH_CACHE_VERSION ||
+        header.source_size != stamp.source_size ||
+        header.source_modification_time != stamp.source_modification_time ||
+        (header.flags & ~MESH_CACHE_SHORT_INDICES) != stamp.flags)
+        return GL_FALSE;
+
+    GLuint   vertex_count = header.vertex_count, face_count = header.face_count;
+    GLuint   index_size = (header.flags & MESH_CACHE_SHORT_INDICES) ? sizeof(GLushort) : sizeof(GLuint);
+    GLuint64 block_size[4] = {3 * (GLuint64)vertex_count * sizeof(GLfloat),
+                              3 * (GLuint64)vertex_count * sizeof(GLfloat),
+                              4 * (GLuint64)vertex_count * sizeof(GLfloat),
+                              3 * (GLuint64)face_count * index_size};
+
+    for (GLuint b = 0; b < 4; ++b)
+        if (header.block_offset[b] % 16 || header.block_offset[b] + block_size[b] > file.GetSize())
+            return GL_FALSE;
+
+    const GLfloat *vertex_block = (const GLfloat*)(file.GetData() + header.block_offset[0]);
+    const GLfloat *normal_block = (const GLfloat*)(file.GetData() + header.block_offset[1]);
+    const char    *index_block  = file.GetData() + header.block_offset[3];
+
+    // the blocks are copied into the geometry in parallel
+    _vertex.resize(vertex_count);
+    _normal.resize(vertex_count);
+    _tex.resize(vertex_count);
+    _face.resize(face_count);
 
-    // save number of vertices, faces, and edges to file
-    GLuint edges = 0;   
-    f << _vertex.size() << _face.size() << edges;
+    [[maybe_unused]] GLint thread_count = TessellationThreadCount(vertex_count + face_count);
 
-          
+    #pragma omp parallel num_threads(thread_count) if(thread_count > 1)
+    {
+        #pragma omp for schedule(static) nowait
+        for (GLint i = 0; i < (GLint)vertex_count; ++i)
+        {
+            for (GLuint component = 0; component < 3; ++component)
+            {
+                _vertex[i][component] = vertex_block[3 * i + component];
+                _normal[i][component] = normal_block[3 * i + component];
+            }
+        }
+
+        #pragma omp for schedule(static)
+        for (GLint i = 0; i < (GLint)face_count; ++i)
+        {
+            for (GLuint node = 0; node < 3; ++node)
+            {
+                if (index_size == sizeof(GLushort))
+                    _face[i][node] = ((const GLushort*)index_block)[3 * i + node];
+                else
+                    _face[i][node] = ((const GLuint*)index_block)[3 * i + node];
+            }
+        }
+    }
 
+    if (vertex_count)
+        memcpy(_tex.data(), file.GetData() + header.block_offset[2], block_size[2]);
+
+    for (GLuint component = 0; component < 3; ++component)
+    {
+        _leftmost_vertex[component]  = header.leftmost_vertex[component];
+        _rightmost_vertex[component] = header.rightmost_vertex[component];
+    }
+
+    // the blocks of the mapped file are passed to the vertex buffer objects without any conversion
+    DeleteVertexBufferObjects();
+
+    glGenBuffers(1, &_vbo_vertices);
+    glGenBuffers(1, &_vbo_normals);
+    glGenBuffers(1, &_vbo_tex_coordinates);
+    glGenBuffers(1, &_vbo_indices);
+
+    if (!_vbo_vertices || !_vbo_normals || !_vbo_tex_coordinates || !_vbo_indices)
+    {
+        DeleteVertexBufferObjects();
+        return GL_TRUE;
+    }
+
+    _usage_flag = usage_flag;
+    _index_type = (index_size == sizeof(GLushort)) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    GLuint vbo[4] = {_vbo_vertices, _vbo_normals, _vbo_tex_coordinates, _vbo_indices};
+
+    for (GLuint b = 0; b < 4; ++b)
+    {
+        GLenum target = b < 3 ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER;
+        glBindBuffer(target, vbo[b]);
+        glBufferData(target, (GLsizeiptr)block_size[b], file.GetData() + header.block_offset[b], _usage_flag);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    vbos_are_updated = GL_TRUE;
 
     return GL_TRUE;
 }
 
+GLboolean TriangulatedMesh3::_SaveToCache(const string& cache_file_name, const CacheStamp& stamp) const
+{
+    GLuint vertex_count = (GLuint)_vertex.size(), face_count = (GLuint)_face.size();
+
+    // 16-bit indices halve the size of the index block of small meshes
+    GLboolean short_indices = vertex_count <= 65536;
+    GLuint    index_size = short_indices ? sizeof(GLushort) : sizeof(GLuint);
+
+    MeshCacheHeader header;
+    memset(&header, 0, sizeof(MeshCacheHeader));
+    memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC));
+
+    header.version                  = MESH_CACHE_VERSION;
+    header.flags                    = stamp.flags | (short_indices ? MESH_CACHE_SHORT_INDICES : 0);
+    header.source_size              = stamp.source_size;
+    header.source_modification_time = stamp.source_modification_time;
+    header.vertex_count             = vertex_count;
+    header.face_count               = face_count;
+
+    for (GLuint component = 0; component < 3; ++component)
+    {
+        header.leftmost_vertex[component]  = _leftmost_vertex[component];
+        header.rightmost_vertex[component] = _rightmost_vertex[component];
+    }
+
+    GLuint64 block_size[4] = {3 * (GLuint64)vertex_count * sizeof(GLfloat),
+                              3 * (GLuint64)vertex_count * sizeof(GLfloat),
+                              4 * (GLuint64)vertex_count * sizeof(GLfloat),
+                              3 * (GLuint64)face_count * index_size};
+
+    header.block_offset[0] = AlignTo16(sizeof(MeshCacheHeader));
+    for (GLuint b = 1; b < 4; ++b)
+        header.block_offset[b] = AlignTo16(header.block_offset[b - 1] + block_size[b - 1]);
+
+    // the blocks are converted into a single buffer, that is written at once into a temporary file,
+    // thus a concurrent load never sees an incomplete cache
+    vector<char> buffer(header.block_offset[3] + block_size[3], 0);
+    memcpy(buffer.data(), &header, sizeof(MeshCacheHeader));
+
+    GLfloat *vertex_block = (GLfloat*)(buffer.data() + header.block_offset[0]);
+    GLfloat *normal_block = (GLfloat*)(buffer.data() + header.block_offset[1]);
+    char    *index_block  = buffer.data() + header.block_offset[3];
+
+    for (GLuint i = 0; i < vertex_count; ++i)
+    {
+        for (GLuint component = 0; component < 3; ++component)
+        {
+            vertex_block[3 * i + component] = (GLfloat)_vertex[i][component];
+            normal_block[3 * i + component] = (GLfloat)_normal[i][component];
+        }
+    }
+
+    if (vertex_count)
+        memcpy(buffer.data() + header.block_offset[2], _tex.data(), block_size[2]);
+
+    for (GLuint i = 0; i < face_count; ++i)
+    {
+        for (GLuint node = 0; node < 3; ++node)
+        {
+            if (short_indices)
+                ((GLushort*)index_block)[3 * i + node] = (GLushort)_face[i][node];
+            else
+                ((GLuint*)index_block)[3 * i + node] = _face[i][node];
+        }
+    }
+
+    string temporary_file_name = cache_file_name + ".tmp";
+
+    FILE *f = fopen(temporary_file_name.c_str(), "wb");
+    if (!f)
+        return GL_FALSE;
+
+    GLboolean written = fwrite(buffer.data(), 1, buffer.size(), f) == buffer.size();
+    written = (fclose(f) == 0) && written;
+
+    if (!written)
+    {
+        remove(temporary_file_name.c_str());
+        return GL_FALSE;
+    }
+
+    // the rename of the C library does not replace existing files on every platform
+    remove(cache_file_name.c_str());
+
+    return rename(temporary_file_name.c_str(), cache_file_name.c_str()) == 0;
+}
+
+GLboolean TriangulatedMesh3::SaveToOFF(const std::string& file_name) const
+{
+    MeshExporter exporter(MeshExporter::Format::OFF);
+    return exporter.Export(file_name, *this);
+}
+
 GLfloat* TriangulatedMesh3::MapVertexBuffer(GLenum access_flag) const
 {
     if (access_flag != GL_READ_ONLY && access_flag != GL_WRITE_ONLY && access_flag != GL_READ_WRITE)
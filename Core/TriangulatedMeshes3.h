@@ -12,8 +12,42 @@ namespace cagd
 {
     class TriangulatedMesh3
     {
+    public:
+        // compressed sparse row (CSR) vertex -> face adjacency: the indices of the faces incident to
+        // the i-th vertex are stored in increasing order by the range [Begin(i), End(i)) of a single
+        // array; it has to be rebuilt whenever the faces change, but not if only the vertices move
+        class VertexFaceAdjacency
+        {
+        protected:
+            std::vector<GLuint> _offset; // prefix sums of the vertex degrees (vertex_count + 1 values)
+            std::vector<GLuint> _face;   // incident faces of the vertices one after the other
+
+        public:
+            // builds the adjacency by a parallel counting sort, fails if a face refers to a vertex
+            // index that is not less than the vertex count
+            GLboolean Build(GLuint vertex_count, const std::vector<TriangularFace>& faces);
+
+            GLvoid Clear();
+
+            // get properties
+            GLuint VertexCount() const;
+            GLuint Degree(GLuint vertex) const;
+
+            const GLuint* Begin(GLuint vertex) const;
+            const GLuint* End(GLuint vertex) const;
+        };
+
+        // weights of the face normals in the average unit normal vectors of the vertices
+        enum class NormalWeighting
+        {
+            UNIFORM = 0,    // unit face normals
+            AREA    = 1,    // face normals of length twice the area of the faces
+            ANGLE   = 2     // unit face normals multiplied by the angles of the faces at the vertex
+        };
+
         friend class ParametricSurface3;
         friend class TensorProductSurface3;
+        friend class MeshExporter;
 
         // homework: output to stream:
         // vertex count, face count
@@ -33,6 +67,8 @@ namespace cagd
         GLuint                      _vbo_normals;
         GLuint                      _vbo_tex_coordinates;
         GLuint                      _vbo_indices;
+        GLenum                      _index_type;   // GL_UNSIGNED_INT, or GL_UNSIGNED_SHORT if the
+                                                   // index buffer was loaded from a binary cache
 
         // corners of bounding box
         DCoordinate3                 _leftmost_vertex;
@@ -44,6 +80,25 @@ namespace cagd
         std::vector<TCoordinate4>    _tex;
         std::vector<TriangularFace>  _face;
 
+        // built by UpdateVertexFaceAdjacency or UpdateUnitNormalVectors
+        VertexFaceAdjacency          _vertex_face_adjacency;
+
+        // the binary cache of LoadFromCachedOFF, the stamp identifies the version of the source file
+        // and the transformation of the vertices
+        struct CacheStamp
+        {
+            GLuint64 source_size{0};
+            GLint64  source_modification_time{0};
+            GLuint   flags{0};
+        };
+
+        // returns GL_FALSE if the cache does not belong to the stamp, then the mesh remains unchanged;
+        // otherwise the geometry is loaded and the success of the update of the vertex buffer objects
+        // is stored by vbos_are_updated
+        GLboolean _LoadFromCache(const std::string& cache_file_name, const CacheStamp& stamp, GLenum usage_flag,
+                                 GLboolean& vbos_are_updated);
+        GLboolean _SaveToCache(const std::string& cache_file_name, const CacheStamp& stamp) const;
+
     public:
         // special and default constructor
         TriangulatedMesh3(GLuint vertex_count = 0, GLuint face_count = 0, GLenum usage_flag = GL_STATIC_DRAW);
@@ -54,6 +109,11 @@ namespace cagd
         // assignment operator
         TriangulatedMesh3& operator =(const TriangulatedMesh3& rhs);
 
+        // move constructor and move assignment operator: the geometry and the vertex buffer
+        // objects are taken over without any copy or OpenGL call, the source becomes empty
+        TriangulatedMesh3(TriangulatedMesh3&& mesh) noexcept;
+        TriangulatedMesh3& operator =(TriangulatedMesh3&& rhs) noexcept;
+
         // deletes all vertex buffer objects
         GLvoid DeleteVertexBufferObjects();
 
@@ -64,10 +124,41 @@ namespace cagd
         GLboolean UpdateVertexBufferObjects(GLenum usage_flag = GL_STATIC_DRAW);
 
         // loads the geometry (i.e. the array of vertices and faces) stored in an OFF file
-        // at the same time calculates the unit normal vectors associated with vertices
+        // at the same time calculates the unit normal vectors associated with vertices;
+        // the file is memory-mapped, records may be separated by any white spaces (comments
+        // starting with # are skipped); if every vertex and face is stored in a separate line,
+        // the lines are parsed in parallel chunks by the tessellation threads, other layouts
+        // are parsed sequentially token by token; polygonal faces are split into
+        // triangles (fans of convex polygons, ear clipping otherwise), hence the face count of the
+        // mesh may exceed the one given in the header
         GLboolean LoadFromOFF(const std::string& file_name, GLboolean translate_and_scale_to_unit_cube = GL_FALSE);
 
-        // homework: saves the geometry into an OFF file
+        // loads an OFF file through a binary cache stored next to it (file_name + ".cache"): if the cache
+        // belongs to the current version of the source file and to the same transformation, it is
+        // memory-mapped, its float32 blocks are passed directly to the vertex buffer objects and the unit
+        // normal vectors are not recalculated; otherwise the OFF file is parsed and the cache is
+        // (re)written; in both cases the vertex buffer objects are updated, i.e., an OpenGL context is
+        // required; the coordinates of a mesh loaded from the cache have float precision; the method
+        // returns GL_FALSE if the file cannot be loaded, or if the vertex buffer objects of the loaded
+        // geometry cannot be updated, the latter case is indicated by vbo_update_failed (if given)
+        GLboolean LoadFromCachedOFF(const std::string& file_name,
+                                    GLboolean translate_and_scale_to_unit_cube = GL_FALSE,
+                                    GLenum usage_flag = GL_STATIC_DRAW,
+                                    GLboolean* vbo_update_failed = nullptr);
+
+        // rebuilds the vertex -> face adjacency of the current faces
+        GLboolean UpdateVertexFaceAdjacency();
+        const VertexFaceAdjacency& GetVertexFaceAdjacency() const;
+
+        // recalculates the average unit normal vectors associated with vertices: the face normals are
+        // calculated in parallel, then every vertex gathers the normals of its incident faces from the
+        // vertex -> face adjacency, thus threads never write to the same normal; if the faces have not
+        // changed since the last update (e.g., the mesh was only deformed), the adjacency can be reused;
+        // the area weighting reproduces the normals of the former serial scatter loop exactly
+        GLboolean UpdateUnitNormalVectors(NormalWeighting weighting = NormalWeighting::AREA,
+                                          GLboolean update_adjacency = GL_TRUE);
+
+        // homework: saves the geometry into an OFF file (see MeshExporter for binary formats)
         GLboolean SaveToOFF(const std::string& file_name) const;
 
         // mapping vertex buffer objects
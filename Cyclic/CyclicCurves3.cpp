@@ -1,6 +1,7 @@
 #include "CyclicCurves3.h"
 
 #include "../Core/Constants.h"
+#include "../Core/FastFourierTransforms.h"
 
 #include <iostream>
 #include <cmath>
@@ -106,4 +107,275 @@ namespace cagd
 
         return GL_TRUE;
     }
+
+    GLvoid CyclicCurve3::_CalculateTrigonometricCoefficients(vector<DCoordinate3>& a, vector<DCoordinate3>& b) const
+    {
+        typedef FastFourierTransform::Complex Complex;
+
+        GLuint size = 2 * _n + 1;
+
+        a.assign(_n + 1, DCoordinate3());
+        b.assign(_n + 1, DCoordinate3());
+
+        // since cos(j (u - i lambda_n)) = cos(j u) cos(j i lambda_n) + sin(j u) sin(j i lambda_n), the
+        // coefficients are the real and imaginary parts of the discrete Fourier transform of the
+        // control points; the x and y coordinates are transformed together
+        vector<Complex> xy(size), z(size);
+        for (GLuint i = 0; i < size; ++i)
+        {
+            xy[i] = Complex(_data[i][0], _data[i][1]);
+            z[i] = Complex(_data[i][2], 0.0);
+        }
+
+        FastFourierTransform::Transform(xy);
+        FastFourierTransform::Transform(z);
+
+        // centroid
+        a[0] = DCoordinate3(xy[0].real(), xy[0].imag(), z[0].real());
+        a[0] /= (GLdouble)size;
+
+        GLdouble scale = 2.0 / size / _bc(2 * _n, _n);
+
+        for (GLuint j = 1; j <= _n; ++j)
+        {
+            // separation of the transforms of the real sequences x and y
+            Complex x_j = 0.5 * (xy[j] + conj(xy[size - j]));
+            Complex y_j = Complex(0.0, -0.5) * (xy[j] - conj(xy[size - j]));
+
+            GLdouble weight = scale * _bc(2 * _n, _n - j);
+
+            a[j] = DCoordinate3(x_j.real(), y_j.real(), z[j].real());
+            a[j] *= weight;
+
+            b[j] = DCoordinate3(x_j.imag(), y_j.imag(), z[j].imag());
+            b[j] *= -weight;
+        }
+    }
+
+    GenericCurve3* CyclicCurve3::GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag) const
+    {
+        typedef FastFourierTransform::Complex Complex;
+
+        if (div_point_count < 2 || _data.GetRowCount() != 2 * _n + 1)
+        {
+            return LinearCombination3::GenerateImage(max_order_of_derivatives, div_point_count, usage_flag);
+        }
+
+        GenericCurve3* result = 0;
+        result = new GenericCurve3(max_order_of_derivatives, div_point_count, usage_flag);
+        if (!result)
+        {
+            return 0;
+        }
+
+        vector<DCoordinate3> a, b;
+        _CalculateTrigonometricCoefficients(a, b);
+
+        // powers of the imaginary unit, i.e., the phase shifts of the derivatives
+        static const Complex i_power[4] = {Complex(1.0, 0.0), Complex(0.0, 1.0), Complex(-1.0, 0.0), Complex(0.0, -1.0)};
+
+        // the last sample coincides with the first one, the remaining ones form a uniform grid
+        // on a whole period, that determines the frequencies 0, 1,..., n without aliasing if it
+        // consists of at least 2n + 1 points; the radix-2 transforms cost O(log(period_count))
+        // operations per sample and order, the recurrence below O(n) ones
+        GLuint period_count = div_point_count - 1;
+
+        GLuint log2_period_count = 0;
+        while ((1u << (log2_period_count + 1)) <= period_count)
+        {
+            ++log2_period_count;
+        }
+
+        if (abs(_u_max - _u_min - TWO_PI) <= EPS && period_count >= 2 * _n + 1 &&
+            FastFourierTransform::IsPowerOfTwo(period_count) && _n >= 2 * log2_period_count)
+        {
+            vector<Complex> xy(period_count), z(period_count);
+
+            for (GLuint r = 0; r <= max_order_of_derivatives; ++r)
+            {
+                fill(xy.begin(), xy.end(), Complex(0.0, 0.0));
+                fill(z.begin(), z.end(), Complex(0.0, 0.0));
+
+                // the normalization of the inverse transform is compensated in advance
+                GLdouble scale = period_count;
+
+                if (!r)
+                {
+                    xy[0] = scale * Complex(a[0][0], a[0][1]);
+                    z[0] = scale * a[0][2];
+                }
+
+                // the r-th derivative of Re((a_j - i b_j) exp(i j u)) is Re((i j)^r (a_j - i b_j) exp(i j u)),
+                // the spectrum of every real coordinate is symmetrized, the coordinates x and y are
+                // the real and imaginary parts of the same complex sequence
+                for (GLuint j = 1; j <= _n; ++j)
+                {
+                    Complex factor = 0.5 * scale * pow((GLdouble)j, (GLint)r) * i_power[r % 4] * polar(1.0, j * _u_min);
+
+                    Complex w[3];
+                    for (GLuint c = 0; c < 3; ++c)
+                    {
+                        w[c] = factor * Complex(a[j][c], -b[j][c]);
+                    }
+
+                    xy[j] += w[0] + Complex(0.0, 1.0) * w[1];
+                    xy[period_count - j] += conj(w[0]) + Complex(0.0, 1.0) * conj(w[1]);
+                    z[j] += w[2];
+                    z[period_count - j] += conj(w[2]);
+                }
+
+                FastFourierTransform::Transform(xy, GL_TRUE);
+                FastFourierTransform::Transform(z, GL_TRUE);
+
+                for (GLuint i = 0; i < period_count; ++i)
+                {
+                    (*result)(r, i) = DCoordinate3(xy[i].real(), xy[i].imag(), z[i].real());
+                }
+
+                (*result)(r, period_count) = (*result)(r, 0);
+            }
+
+            return result;
+        }
+
+        // otherwise cos(j u) and sin(j u) are generated by the angle addition formulas
+        GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
+
+        for (GLuint i = 0; i < div_point_count; ++i)
+        {
+            GLdouble u = min(_u_min + i * u_step, _u_max);
+
+            GLdouble cos_u = cos(u), sin_u = sin(u);
+            GLdouble cos_ju = 1.0, sin_ju = 0.0;
+
+            (*result)(0, i) = a[0];
+
+            for (GLuint j = 1; j <= _n; ++j)
+            {
+                GLdouble cos_next = cos_ju * cos_u - sin_ju * sin_u;
+                sin_ju = sin_ju * cos_u + cos_ju * sin_u;
+                cos_ju = cos_next;
+
+                // the derivatives of a_j cos(j u) + b_j sin(j u) cycle through
+                // j^r (e_j, f_j, -e_j, -f_j), where e_j = a_j cos(j u) + b_j sin(j u)
+                // and f_j = b_j cos(j u) - a_j sin(j u)
+                DCoordinate3 e = a[j] * cos_ju + b[j] * sin_ju;
+                DCoordinate3 f = b[j] * cos_ju - a[j] * sin_ju;
+
+                GLdouble j_power = 1.0;
+                for (GLuint r = 0; r <= max_order_of_derivatives; ++r)
+                {
+                    DCoordinate3 &derivative = (*result)(r, i);
+
+                    switch (r % 4)
+                    {
+                    case 0: derivative += e * j_power; break;
+                    case 1: derivative += f * j_power; break;
+                    case 2: derivative -= e * j_power; break;
+                    case 3: derivative -= f * j_power; break;
+                    }
+
+                    j_power *= j;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    GLboolean CyclicCurve3::InterpolationSignature(std::vector<GLdouble>& signature) const
+    {
+        signature.push_back(_n);
+        return GL_TRUE;
+    }
+
+    GLboolean CyclicCurve3::_IsUniformKnotVector(const ColumnMatrix<GLdouble>& knot_vector) const
+    {
+        if (knot_vector.GetRowCount() != 2 * _n + 1)
+        {
+            return GL_FALSE;
+        }
+
+        for (GLuint j = 1; j <= 2 * _n; ++j)
+        {
+            if (abs(knot_vector[j] - knot_vector[0] - j * _lambda_n) > EPS)
+            {
+                return GL_FALSE;
+            }
+        }
+
+        return GL_TRUE;
+    }
+
+    GLboolean CyclicCurve3::_SolveCirculantInterpolationProblem(GLdouble u_0, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate)
+    {
+        typedef FastFourierTransform::Complex Complex;
+
+        GLuint size = 2 * _n + 1;
+
+        // since (1 + cos(t))^n = 2^{-n} sum_{l=0}^{2n} binom(2n, l) exp(i (n - l) t), the eigenvalues of
+        // the collocation matrix, i.e., the discrete Fourier transform of its first column
+        // a_k = F_0(u_0 + k lambda_n), are known in closed form:
+        //
+        // hat{a}_m = (2n + 1) c_n 2^{-n} binom(2n, l) exp(i (n - l) u_0), where l = (n - m) mod (2n + 1);
+        //
+        // unlike the transform of the sampled column, the closed form stays accurate also for the
+        // tiny eigenvalues of high order curves
+        vector<Complex> spectrum(size);
+        GLdouble scale = size * _c_n * pow(0.5, (GLint)_n);
+        for (GLuint m = 0; m < size; ++m)
+        {
+            GLuint l = (_n + size - m) % size;
+            spectrum[m] = scale * _bc(2 * _n, l) * polar(1.0, ((GLdouble)_n - (GLdouble)l) * u_0);
+        }
+
+        for (GLuint m = 0; m < size; ++m)
+        {
+            if (spectrum[m] == 0.0)
+            {
+                return GL_FALSE;
+            }
+        }
+
+        // the collocation matrix is real, thus the x and y coordinates can be solved as the real
+        // and imaginary parts of a single complex right-hand side
+        vector<Complex> xy(size), z(size);
+        for (GLuint j = 0; j < size; ++j)
+        {
+            const DCoordinate3 &d = data_points_to_interpolate[j];
+            xy[j] = Complex(d[0], d[1]);
+            z[j] = Complex(d[2], 0.0);
+        }
+
+        FastFourierTransform::Transform(xy);
+        FastFourierTransform::Transform(z);
+
+        for (GLuint m = 0; m < size; ++m)
+        {
+            xy[m] /= spectrum[m];
+            z[m] /= spectrum[m];
+        }
+
+        FastFourierTransform::Transform(xy, GL_TRUE);
+        FastFourierTransform::Transform(z, GL_TRUE);
+
+        for (GLuint i = 0; i < size; ++i)
+        {
+            _data[i] = DCoordinate3(xy[i].real(), xy[i].imag(), z[i].real());
+        }
+
+        return GL_TRUE;
+    }
+
+    GLboolean CyclicCurve3::UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate)
+    {
+        if (data_points_to_interpolate.GetRowCount() == 2 * _n + 1 &&
+            _IsUniformKnotVector(knot_vector) &&
+            _SolveCirculantInterpolationProblem(knot_vector[0], data_points_to_interpolate))
+        {
+            return GL_TRUE;
+        }
+
+        return LinearCombination3::UpdateDataForInterpolation(knot_vector, data_points_to_interpolate);
+    }
 }
@@ -3,6 +3,8 @@
 #include "../Core/LinearCombination3.h"
 #include "../Core/Matrices.h"
 
+#include <vector>
+
 namespace cagd
 {
     class CyclicCurve3: public LinearCombination3
@@ -18,6 +20,18 @@ namespace cagd
 
         GLvoid      _CalculateBinomialCoefficients(GLuint m, TriangularMatrix<GLdouble>& bc);
 
+        // decides whether the knots are of the form u_j = u_0 + j * lambda_n, j = 0, 1,..., 2n
+        GLboolean   _IsUniformKnotVector(const ColumnMatrix<GLdouble>& knot_vector) const;
+
+        // in case of uniform knots the collocation matrix [F_i(u_j)] = [c_n (1 + cos(u_0 + (j - i) lambda_n))^n]
+        // is circulant, i.e., the interpolation problem is a circular convolution that can be solved
+        // by fast Fourier transforms in O(n log n) operations
+        GLboolean   _SolveCirculantInterpolationProblem(GLdouble u_0, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate);
+
+        // converts the control polygon into the trigonometric form
+        // c(u) = a_0 + sum_{j=1}^{n} (a_j cos(j u) + b_j sin(j u)) by means of a single discrete Fourier transform
+        GLvoid      _CalculateTrigonometricCoefficients(std::vector<DCoordinate3>& a, std::vector<DCoordinate3>& b) const;
+
     public:
         //special constructor
         CyclicCurve3(GLuint n, GLenum data_usage_flag = GL_STATIC_DRAW);
@@ -25,5 +39,18 @@ namespace cagd
         // redeclare and define inherited pure virtual methods
         GLboolean BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble> &values) const;
         GLboolean CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives &d) const;
+
+        // the trigonometric coefficients are calculated once; if the samples form a power of two
+        // sized grid on the whole period and the order is high enough, all of them are obtained by
+        // inverse FFTs, one per order of derivatives, otherwise by the angle addition recurrence of
+        // cos(j u) and sin(j u)
+        GenericCurve3* GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
+
+        // assures interpolation, uniform knots are handled by the circulant solver, other ones by
+        // the LU decomposition of the collocation matrix
+        GLboolean UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate);
+
+        // interpolation-plan hook, the blending functions are determined by the order
+        GLboolean InterpolationSignature(std::vector<GLdouble>& signature) const;
     };
 }
@@ -315,27 +315,22 @@ namespace cagd
     void GLWidget::initOffModel()
     {
         _off_models.resize(3);
-        if (_off_models[0].LoadFromOFF("Models/elephant.off", true))
-        {
-            if (!_off_models[0].UpdateVertexBufferObjects(GL_DYNAMIC_DRAW))
-            {
-                throw std::runtime_error("Error while loading off model");
-            }
-        }
-        if (_off_models[1].LoadFromOFF("Models/mouse.off", true))
-        {
-            if (!_off_models[1].UpdateVertexBufferObjects(GL_DYNAMIC_DRAW))
-            {
-                throw std::runtime_error("Error while loading off model");
-            }
-        }
-        if (_off_models[2].LoadFromOFF("Models/sphere.off", true))
+
+        // the models are parsed only at the first start, later starts map their binary caches;
+        // models that cannot be loaded are not rendered, while loaded models without vertex buffer
+        // objects are errors
+        const char *file_names[3] = {"Models/elephant.off", "Models/mouse.off", "Models/sphere.off"};
+
+        for (GLuint i = 0; i < 3; i++)
         {
-            if (!_off_models[2].UpdateVertexBufferObjects(GL_DYNAMIC_DRAW))
+            GLboolean vbo_update_failed = GL_FALSE;
+            if (!_off_models[i].LoadFromCachedOFF(file_names[i], true, GL_DYNAMIC_DRAW, &vbo_update_failed) &&
+                vbo_update_failed)
             {
                 throw std::runtime_error("Error while loading off model");
             }
         }
+
         _angle = 0.0;
         _timer->start();
     }
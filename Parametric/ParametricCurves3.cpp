@@ -1,4 +1,5 @@
 #include "ParametricCurves3.h"
+#include "../Core/Parallelism.h"
 
 using namespace cagd;
 using namespace std;
@@ -42,13 +43,15 @@ GenericCurve3* ParametricCurve3::GenerateImage(GLuint div_point_count, GLenum us
         (*result)(order, div_point_count - 1) = _derivatives[order](_u_max);
     }
 
-    // calculate derivatives at inner curve points
+    // calculate derivatives at inner curve points, the parameter values are not accumulated,
+    // thus every point can be calculated by any of the tessellation threads
     GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
-    GLdouble u = _u_min;
+    [[maybe_unused]] GLint thread_count = TessellationThreadCount(div_point_count);
 
-    for (GLuint i = 1; i < div_point_count - 1; i++)
+    #pragma omp parallel for num_threads(thread_count) if(thread_count > 1) schedule(static)
+    for (GLint i = 1; i < (GLint)div_point_count - 1; i++)
     {
-        u += u_step;
+        GLdouble u = min(_u_min + i * u_step, _u_max);
 
         for (GLuint order = 0; order < _derivatives.GetColumnCount(); ++order)
         {
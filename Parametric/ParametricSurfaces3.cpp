@@ -1,4 +1,5 @@
 #include "ParametricSurfaces3.h"
+#include "../Core/Parallelism.h"
 
 #include <cstdlib>
 #include <cmath>
@@ -51,18 +52,20 @@ namespace cagd
         GLdouble ds = 1.0 / (u_div_point_count - 1);
         GLdouble dt = 1.0 / (v_div_point_count - 1);
 
-        // current triangular face counter
-        GLuint current_face = 0;
+        // the grid rows are distributed among the tessellation threads
+        [[maybe_unused]] GLint thread_count = TessellationThreadCount(u_div_point_count * v_div_point_count);
 
-        for (GLuint i = 0; i < u_div_point_count; ++i)
+        #pragma omp parallel for num_threads(thread_count) if(thread_count > 1) schedule(static)
+        for (GLint signed_i = 0; signed_i < (GLint)u_div_point_count; ++signed_i)
         {
+            GLuint   i = (GLuint)signed_i;
             GLdouble u = min(_u_min + i * du, _u_max);
             GLdouble s = min(i * ds, 1.0);
 
             for (GLuint j = 0; j < v_div_point_count; ++j)
             {
                 GLdouble v = min(_v_min + j * dv, _v_max);
-                GLdouble t = min(i * dt, 1.0);
+                GLdouble t = min(j * dt, 1.0);
 
                 /*
                     3-2
@@ -90,9 +93,12 @@ namespace cagd
                 (*result)._tex[index[0]].s() = s;
                 (*result)._tex[index[0]].t() = t;
 
-                // connectivity information
+                // connectivity information, the index of the current triangular face follows
+                // from the grid position
                 if (i < u_div_point_count - 1 && j < v_div_point_count - 1)
                 {
+                    GLuint current_face = 2 * (i * (v_div_point_count - 1) + j);
+
                     (*result)._face[current_face][0] = index[0];
                     (*result)._face[current_face][1] = index[1];
                     (*result)._face[current_face][2] = index[2];
@@ -101,7 +107,6 @@ namespace cagd
                     (*result)._face[current_face][0] = index[0];
                     (*result)._face[current_face][1] = index[2];
                     (*result)._face[current_face][2] = index[3];
-                    ++current_face;
                 }
             }
         }
@@ -1,5 +1,8 @@
 QT += core gui widgets opengl
 
+# the OFF loader and the mesh exporters convert numbers by std::from_chars and std::to_chars
+CONFIG += c++17
+
 win32 {
     message("Windows platform...")
 
@@ -37,6 +40,10 @@ unix: !mac {
 
     # for GLEW installed into /usr/lib/libGLEW.so or /usr/lib/glew.lib
     LIBS += -lGLEW -lGLU
+
+    # enables the multithreaded tessellation of the GenerateImage methods
+    QMAKE_CXXFLAGS += -fopenmp
+    QMAKE_LFLAGS += -fopenmp
 }
 
 mac {
@@ -66,9 +73,16 @@ HEADERS += \
     Core/DCoordinates3.h \
     Core/GenericCurves3.h \
     Core/Matrices.h \
+    Core/InterpolationPlanCache.h \
+    Core/FastFourierTransforms.h \
+    Core/Parallelism.h \
+    Core/CpuFeatures.h \
+    Core/MemoryMappedFiles.h \
+    Core/MeshExporters.h \
     Core/RealSquareMatrices.h \
     Parametric/ParametricCurves3.h \
     SOQAH/BlendingFunctionUtil.h \
+    SOQAH/BlendingFunctionTableCache.h \
     SOQAH/SOQAHPatch3.h \
     Test/TestFunctions.h \
     Parametric/ParametricSurfaces3.h \
@@ -85,7 +99,8 @@ HEADERS += \
     Core/ShaderPrograms.h \
     SOQAH/SOQAHArcs3.h \
     SOQAH/SOQAHCompositeCurve3.h \
-    SOQAH/SOQAHCompositeSurface3.h
+    SOQAH/SOQAHCompositeSurface3.h \
+    SOQAH/SOQAHStreamingArcFitter.h
 
 SOURCES += \
     GUI/GLWidget.cpp \
@@ -93,8 +108,11 @@ SOURCES += \
     GUI/SideWidget.cpp \
     Core/GenericCurves3.cpp \
     Core/RealSquareMatrices.cpp \
+    Core/InterpolationPlanCache.cpp \
+    Core/FastFourierTransforms.cpp \
     Parametric/ParametricCurves3.cpp \
     SOQAH/BlendingFunctionUtil.cpp \
+    SOQAH/BlendingFunctionTableCache.cpp \
     SOQAH/SOQAHPatch3.cpp \
     Test/TestFunctions.cpp \
     main.cpp \
@@ -102,11 +120,14 @@ SOURCES += \
     Core/Lights.cpp \
     Core/Materials.cpp \
     Core/TriangulatedMeshes3.cpp \
+    Core/MemoryMappedFiles.cpp \
+    Core/MeshExporters.cpp \
     Cyclic/CyclicCurves3.cpp \
     Core/LinearCombination3.cpp \
     Core/TensorProductSurfaces3.cpp \
     Core/ShaderPrograms.cpp \
     SOQAH/SOQAHArcs3.cpp \
     SOQAH/SOQAHCompositeCurve3.cpp \
-    SOQAH/SOQAHCompositeSurface3.cpp
+    SOQAH/SOQAHCompositeSurface3.cpp \
+    SOQAH/SOQAHStreamingArcFitter.cpp
 
@@ -0,0 +1,110 @@
+#include "BlendingFunctionTableCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+using namespace cagd;
+
+mutex BlendingFunctionTableCache::_mutex;
+map<BlendingFunctionTableCache::Key, BlendingFunctionTableCache::Table> BlendingFunctionTableCache::_tables;
+
+BlendingFunctionTableCache::Table BlendingFunctionTableCache::GetUniformTable(
+        const BlendingFunctionUtil& util, GLdouble u_min, GLdouble u_max, GLuint div_point_count, GLuint max_order)
+{
+    if (div_point_count < 2 || max_order > 2 || !(u_min < u_max))
+    {
+        return Table();
+    }
+
+    Key key(util.getAlpha(), u_min, u_max, div_point_count, max_order);
+
+    {
+        lock_guard<mutex> lock(_mutex);
+        auto it = _tables.find(key);
+        if (it != _tables.end())
+        {
+            return it->second;
+        }
+    }
+
+    // the table is calculated outside of the critical section, if two threads race for the same
+    // key, the first inserted table wins and the other one is discarded
+    shared_ptr<Matrix<GLdouble> > table = make_shared<Matrix<GLdouble> >();
+    if (!util.EvaluateUniform(u_min, u_max, div_point_count, max_order, *table))
+    {
+        return Table();
+    }
+
+    lock_guard<mutex> lock(_mutex);
+    if (_tables.size() >= _maximum_table_count)
+    {
+        _tables.clear();
+    }
+
+    return _tables.insert(make_pair(key, Table(table))).first->second;
+}
+
+GLboolean BlendingFunctionTableCache::IsUniformSubdivision(const GLdouble* u, GLuint count)
+{
+    if (count < 2)
+    {
+        return GL_FALSE;
+    }
+
+    GLdouble u_min = u[0], u_max = u[count - 1];
+    if (!(u_min < u_max))
+    {
+        return GL_FALSE;
+    }
+
+    // the tolerance is relative to the magnitude of the bounds, i.e., to the rounding errors of the
+    // formulas that calculate the parameter values
+    GLdouble du = (u_max - u_min) / (count - 1);
+    GLdouble tolerance = 16.0 * numeric_limits<GLdouble>::epsilon() * max(fabs(u_min), fabs(u_max));
+
+    for (GLuint k = 1; k < count - 1; k++)
+    {
+        if (fabs(u[k] - min(u_min + k * du, u_max)) > tolerance)
+        {
+            return GL_FALSE;
+        }
+    }
+
+    return GL_TRUE;
+}
+
+BlendingFunctionTableCache::Table BlendingFunctionTableCache::Evaluate(
+        const BlendingFunctionUtil& util, const GLdouble* u, GLuint count, GLuint max_order)
+{
+    if (IsUniformSubdivision(u, count))
+    {
+        Table cached = GetUniformTable(util, u[0], u[count - 1], count, max_order);
+        if (cached)
+        {
+            return cached;
+        }
+    }
+
+    shared_ptr<Matrix<GLdouble> > table = make_shared<Matrix<GLdouble> >();
+    if (!util.EvaluateBatch(u, count, max_order, *table))
+    {
+        return Table();
+    }
+
+    return table;
+}
+
+GLvoid BlendingFunctionTableCache::Clear()
+{
+    lock_guard<mutex> lock(_mutex);
+    _tables.clear();
+}
+
+GLuint BlendingFunctionTableCache::GetTableCount()
+{
+    lock_guard<mutex> lock(_mutex);
+    return (GLuint)_tables.size();
+}
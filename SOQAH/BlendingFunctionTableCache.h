@@ -0,0 +1,52 @@
+#pragma once
+
+#include "./BlendingFunctionUtil.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace cagd
+{
+    // process-wide, thread-safe cache of blending function tables that belong to uniform
+    // subdivisions of parameter intervals (usually of the definition domain [0, alpha]); since every
+    // patch and arc of a composite shares the same alpha and division count, re-tessellation needs
+    // no transcendental function evaluation at all after the first one
+    class BlendingFunctionTableCache
+    {
+    public:
+        // shared, read-only table in the layout of BlendingFunctionUtil::EvaluateBatch
+        typedef std::shared_ptr<const Matrix<GLdouble> > Table;
+
+        // returns the table of the parameter values u_k = min(u_min + k * (u_max - u_min) / (div_point_count - 1), u_max),
+        // k = 0, 1,..., div_point_count - 1, the table is calculated only at the first request
+        static Table GetUniformTable(const BlendingFunctionUtil& util, GLdouble u_min, GLdouble u_max,
+                                     GLuint div_point_count, GLuint max_order);
+
+        // decides whether the given parameter values form the uniform subdivision above, where u_min = u[0]
+        // and u_max = u[count - 1]; the values may differ from the exact ones by a few ulps of the bounds,
+        // since the tessellation methods may accumulate or clamp them differently
+        static GLboolean IsUniformSubdivision(const GLdouble* u, GLuint count);
+
+        // returns the table either from the cache (for uniform subdivisions) or by batch evaluation, an
+        // empty pointer indicates failure; cached tables are shared, not copied
+        static Table Evaluate(const BlendingFunctionUtil& util, const GLdouble* u, GLuint count, GLuint max_order);
+
+        // releases every cached table
+        static GLvoid Clear();
+
+        // number of cached tables
+        static GLuint GetTableCount();
+
+    private:
+        // at most this many tables are kept, the whole cache is cleared when it overflows
+        static const GLuint _maximum_table_count = 64;
+
+        // key: (alpha, u_min, u_max, division point count, maximum order of derivatives)
+        typedef std::tuple<GLdouble, GLdouble, GLdouble, GLuint, GLuint> Key;
+
+        static std::mutex           _mutex;
+        static std::map<Key, Table> _tables;
+    };
+}
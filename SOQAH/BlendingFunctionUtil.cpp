@@ -1,12 +1,45 @@
 #include "BlendingFunctionUtil.h"
+#include "../Core/CpuFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace std;
 
 using namespace cagd;
 
 BlendingFunctionUtil::BlendingFunctionUtil(GLdouble alpha)
+{
+    setAlpha(alpha);
+}
+
+GLvoid BlendingFunctionUtil::setAlpha(GLdouble alpha)
 {
     _alpha = alpha;
+
+    _alpha2 = _alpha * _alpha;
+    _sinh_alpha = sinh(_alpha);
+    _cosh_alpha = cosh(_alpha);
+    _exp_alpha = exp(_alpha);
+    _exp_minus_alpha = exp(-_alpha);
+
+    GLdouble a2 = _alpha2;
+    GLdouble sha = _sinh_alpha;
+    GLdouble cha = _cosh_alpha;
+
+    GLdouble c2_s = (2 * _alpha * sha - 4 * cha + 4);
+    GLdouble c2_gy_n = (4 * cha + a2+ a2* cha - 4 * _alpha * sha - 4);
+    _constant2 = c2_s / (c2_gy_n * c2_gy_n);
+
+    _constant3 = (2 * (sha - _alpha)) / ((4 * cha + a2 + a2 * cha - 4 * _alpha * sha - 4) * (a2 - 2 * cha + 2));
+
+    _constant4 = 1.0 / (2 * cha - a2 - 2);
+}
+
+GLdouble BlendingFunctionUtil::getAlpha() const
+{
+    return _alpha;
 }
 
 GLdouble BlendingFunctionUtil::blendingFunction00(GLdouble u) const
@@ -22,17 +55,17 @@ GLdouble BlendingFunctionUtil::blendingFunction01(GLdouble u) const
 GLdouble BlendingFunctionUtil::blendingFunction02(GLdouble u) const
 {
     // forward calculation in order to increas the speed of the formula's evaluation
-    GLdouble a2 = _alpha * _alpha;
+    GLdouble a2 = _alpha2;
     GLdouble u2 = u * u;
-    GLdouble sha = sinh(_alpha);
-    GLdouble cha = cosh(_alpha);
+    GLdouble sha = _sinh_alpha;
+    GLdouble cha = _cosh_alpha;
     GLdouble shu = sinh(u);
     GLdouble chu = cosh(u);
 
-    GLdouble h = getConstant2() * (a2 * chu + 2 * u2 * cha + a2 * cosh(_alpha - u) + 2 * u * _alpha - a2 - a2 * cha - 2 * _alpha * shu
+    GLdouble h = _constant2 * (a2 * chu + 2 * u2 * cha + a2 * cosh(_alpha - u) + 2 * u * _alpha - a2 - a2 * cha - 2 * _alpha * shu
                 - 2 * _alpha * sinh(_alpha - u) + 2 * _alpha * sha - 2 * u2 + u * a2 * sha - u2 * _alpha * sha - 2 * u * _alpha * cha);
 
-    GLdouble k = getConstant3() * (2 * (_alpha - u) + 2 * sinh(_alpha - u) + 2 * (shu - sha) + a2 * (shu - u) + u2 * (_alpha - sha)
+    GLdouble k = _constant3 * (2 * (_alpha - u) + 2 * sinh(_alpha - u) + 2 * (shu - sha) + a2 * (shu - u) + u2 * (_alpha - sha)
                 + 2 * (u * cha - _alpha * chu));
 
     return 0.5 * h + k;
@@ -40,7 +73,7 @@ GLdouble BlendingFunctionUtil::blendingFunction02(GLdouble u) const
 
 GLdouble BlendingFunctionUtil::blendingFunction03(GLdouble u) const
 {
-    return getConstant4() * (2 * cosh(u) - u * u - 2);
+    return _constant4 * (2 * cosh(u) - u * u - 2);
 }
 
 // 1st order derivatives
@@ -57,15 +90,15 @@ GLdouble BlendingFunctionUtil::blendingFunction11(GLdouble u) const
 GLdouble BlendingFunctionUtil::blendingFunction12(GLdouble u) const
 {
     // forward calculation in order to increas the speed of the formula's evaluation
-    GLdouble a2 = _alpha * _alpha;
-    GLdouble sha = sinh(_alpha);
-    GLdouble cha = cosh(_alpha);
+    GLdouble a2 = _alpha2;
+    GLdouble sha = _sinh_alpha;
+    GLdouble cha = _cosh_alpha;
     GLdouble shu = sinh(u);
     GLdouble chu = cosh(u);
 
-    GLdouble k = getConstant3() * (-2 -2*cosh(_alpha - u) + 2*chu + a2*(chu - 1) + 2*u*(_alpha - sha) + 2*(cha - _alpha*(shu)));
+    GLdouble k = _constant3 * (-2 -2*cosh(_alpha - u) + 2*chu + a2*(chu - 1) + 2*u*(_alpha - sha) + 2*(cha - _alpha*(shu)));
 
-    GLdouble h = getConstant2() * (a2*shu + a2*sha - a2*sinh(_alpha - u) + 2*_alpha + 2*_alpha*cosh(_alpha - u) - 2*_alpha*u*sha
+    GLdouble h = _constant2 * (a2*shu + a2*sha - a2*sinh(_alpha - u) + 2*_alpha + 2*_alpha*cosh(_alpha - u) - 2*_alpha*u*sha
                                    - 2*_alpha*chu - 2*_alpha*cha + 4*u*cha - 4*u);
 
     return 0.5 * h + k;
@@ -73,7 +106,7 @@ GLdouble BlendingFunctionUtil::blendingFunction12(GLdouble u) const
 
 GLdouble BlendingFunctionUtil::blendingFunction13(GLdouble u) const
 {
-    return getConstant4() * (2 * sinh(u) - 2 * u);
+    return _constant4 * (2 * sinh(u) - 2 * u);
 }
 
 // 2nd order derivatives
@@ -90,49 +123,434 @@ GLdouble BlendingFunctionUtil::blendingFunction21(GLdouble u) const
 GLdouble BlendingFunctionUtil::blendingFunction22(GLdouble u) const
 {
     // forward calculation in order to increas the speed of the formula's evaluation
-    GLdouble a2 = _alpha * _alpha;
-    GLdouble sha = sinh(_alpha);
-    GLdouble cha = cosh(_alpha);
+    GLdouble a2 = _alpha2;
+    GLdouble sha = _sinh_alpha;
+    GLdouble cha = _cosh_alpha;
     GLdouble shu = sinh(u);
     GLdouble chu = cosh(u);
 
-    GLdouble k = getConstant3() * (2*sinh(_alpha - u) + 2*shu + a2*shu - 2*_alpha*chu + 2*(_alpha - sha));
+    GLdouble k = _constant3 * (2*sinh(_alpha - u) + 2*shu + a2*shu - 2*_alpha*chu + 2*(_alpha - sha));
 
-    GLdouble h = getConstant2() * (a2*chu + a2*cosh(_alpha - u) - 2*_alpha*shu - 2*_alpha*sinh(_alpha - u) - 2*_alpha*sha + 4*cha - 4);
+    GLdouble h = _constant2 * (a2*chu + a2*cosh(_alpha - u) - 2*_alpha*shu - 2*_alpha*sinh(_alpha - u) - 2*_alpha*sha + 4*cha - 4);
     return 0.5 * h + k;
 }
 
 GLdouble BlendingFunctionUtil::blendingFunction23(GLdouble u) const
 {
-    return getConstant4() * (2 * cosh(u) - 2);
+    return _constant4 * (2 * cosh(u) - 2);
 }
 
 GLdouble BlendingFunctionUtil::getConstant2() const
 {
-    GLdouble a2 = _alpha * _alpha;
-    GLdouble sha = sinh(_alpha);
-    GLdouble cha = cosh(_alpha);
+    return _constant2;
+}
 
-    GLdouble c2_s = (2 * _alpha * sha - 4 * cha + 4);
-    GLdouble c2_gy_n = (4 * cha + a2+ a2* cha - 4 * _alpha * sha - 4);
-    GLdouble c2 = c2_s / (c2_gy_n * c2_gy_n);
+GLdouble BlendingFunctionUtil::getConstant3() const
+{
+    return _constant3;
+}
 
-    return c2;
+GLdouble BlendingFunctionUtil::getConstant4() const
+{
+    return _constant4;
 }
 
-GLdouble BlendingFunctionUtil::getConstant3() const
+// fused evaluation of all blending functions
+GLboolean BlendingFunctionUtil::EvaluateAll(GLdouble u, GLuint max_order, GLdouble out[3][4]) const
 {
-    GLdouble a2 = _alpha * _alpha;
-    GLdouble sha = sinh(_alpha);
-    GLdouble cha = cosh(_alpha);
+    if (max_order > 2)
+    {
+        return GL_FALSE;
+    }
 
-    GLdouble c3 = (2 * (sha - _alpha)) / ((4 * cha + a2 + a2 * cha - 4 * _alpha * sha - 4) * (a2 - 2 * cha + 2));
+    GLdouble w = _alpha - u;
+    _evaluateAll(u, sinh(u), cosh(u), sinh(w), cosh(w), max_order, out);
 
-    return c3;
+    return GL_TRUE;
 }
 
-GLdouble BlendingFunctionUtil::getConstant4() const
+GLvoid BlendingFunctionUtil::_evaluateAll(
+        GLdouble u, GLdouble shu, GLdouble chu,
+        GLdouble shw, GLdouble chw,
+        GLuint max_order, GLdouble out[3][4]) const
+{
+    // the hyperbolic terms at w = alpha - u are given, since the addition theorems
+    // sinh(alpha) cosh(u) - cosh(alpha) sinh(u), etc. cancel catastrophically as alpha grows
+    GLdouble w = _alpha - u;
+
+    // F_3 and its derivatives at u, F_0 is its mirror image, i.e., F_0(u) = F_3(alpha - u)
+    out[0][3] = _constant4 * (2 * chu - u * u - 2);
+    out[0][0] = _constant4 * (2 * chw - w * w - 2);
+
+    // F_2 and its derivatives at u, F_1 is its mirror image, i.e., F_1(u) = F_2(alpha - u)
+    GLdouble f2[3], f1[3];
+    _evaluateSecondFunction(u, shu, chu, w, shw, chw, max_order, f2);
+    _evaluateSecondFunction(w, shw, chw, u, shu, chu, max_order, f1);
+
+    out[0][1] = f1[0];
+    out[0][2] = f2[0];
+
+    if (max_order >= 1)
+    {
+        out[1][0] = -_constant4 * (2 * shw - 2 * w);
+        out[1][1] = -f1[1];
+        out[1][2] = f2[1];
+        out[1][3] = _constant4 * (2 * shu - 2 * u);
+    }
+
+    if (max_order >= 2)
+    {
+        out[2][0] = _constant4 * (2 * chw - 2);
+        out[2][1] = f1[2];
+        out[2][2] = f2[2];
+        out[2][3] = _constant4 * (2 * chu - 2);
+    }
+}
+
+GLvoid BlendingFunctionUtil::_evaluateSecondFunction(
+        GLdouble u, GLdouble shu, GLdouble chu,
+        GLdouble w, GLdouble shw, GLdouble chw,
+        GLuint max_order, GLdouble values[3]) const
 {
-    GLdouble c4 = 1.0 / (2 * cosh(_alpha) - _alpha * _alpha - 2);
-    return c4;
+    GLdouble a2 = _alpha2;
+    GLdouble u2 = u * u;
+    GLdouble sha = _sinh_alpha;
+    GLdouble cha = _cosh_alpha;
+
+    GLdouble h = _constant2 * (a2 * chu + 2 * u2 * cha + a2 * chw + 2 * u * _alpha - a2 - a2 * cha - 2 * _alpha * shu
+                - 2 * _alpha * shw + 2 * _alpha * sha - 2 * u2 + u * a2 * sha - u2 * _alpha * sha - 2 * u * _alpha * cha);
+
+    GLdouble k = _constant3 * (2 * w + 2 * shw + 2 * (shu - sha) + a2 * (shu - u) + u2 * (_alpha - sha)
+                + 2 * (u * cha - _alpha * chu));
+
+    values[0] = 0.5 * h + k;
+
+    if (max_order >= 1)
+    {
+        k = _constant3 * (-2 -2*chw + 2*chu + a2*(chu - 1) + 2*u*(_alpha - sha) + 2*(cha - _alpha*(shu)));
+
+        h = _constant2 * (a2*shu + a2*sha - a2*shw + 2*_alpha + 2*_alpha*chw - 2*_alpha*u*sha
+                          - 2*_alpha*chu - 2*_alpha*cha + 4*u*cha - 4*u);
+
+        values[1] = 0.5 * h + k;
+    }
+
+    if (max_order >= 2)
+    {
+        k = _constant3 * (2*shw + 2*shu + a2*shu - 2*_alpha*chu + 2*(_alpha - sha));
+
+        h = _constant2 * (a2*chu + a2*chw - 2*_alpha*shu - 2*_alpha*shw - 2*_alpha*sha + 4*cha - 4);
+
+        values[2] = 0.5 * h + k;
+    }
+}
+
+#if CAGD_AVX2_KERNELS
+// calculates sinh and cosh of four parameter values at once: exp(x) = 2^k exp(r) is obtained by
+// range reduction, where |r| <= ln(2) / 2 and exp(r) is approximated by its Taylor polynomial
+// of degree 13; for |x| < 1 the sinh function is evaluated by its own odd Taylor polynomial in
+// order to avoid cancellation; it is compiled for AVX2 and FMA, thus it may be called only if
+// ProcessorSupportsAVX2() holds
+CAGD_TARGET_AVX2 static GLvoid _hyperbolicFunctions4(const GLdouble* x, GLdouble* sinh_x, GLdouble* cosh_x)
+{
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0); // 1.5 * 2^52
+
+    __m256d v = _mm256_loadu_pd(x);
+    __m256d a = _mm256_min_pd(_mm256_max_pd(v, _mm256_set1_pd(-708.0)), _mm256_set1_pd(708.0));
+
+    __m256d k = _mm256_round_pd(_mm256_mul_pd(a, _mm256_set1_pd(1.4426950408889634074)),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(6.93147180369123816490e-01), a);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(1.90821492927058770002e-10), r);
+
+    // Horner scheme of sum_{i=0}^{13} r^i / i!
+    __m256d p = _mm256_set1_pd(1.0 / 6227020800.0);
+    const GLdouble inverse_factorials[] =
+    {
+        1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0,
+        1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0
+    };
+    for (GLuint i = 0; i < 13; i++)
+    {
+        p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(inverse_factorials[i]));
+    }
+
+    // multiplication by 2^k through the exponent bits
+    __m256i ki = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(k, magic)), _mm256_castpd_si256(magic));
+    __m256i exponent = _mm256_slli_epi64(_mm256_add_epi64(ki, _mm256_set1_epi64x(1023)), 52);
+    __m256d e = _mm256_mul_pd(p, _mm256_castsi256_pd(exponent));
+    __m256d inverse_e = _mm256_div_pd(one, e);
+
+    __m256d c = _mm256_mul_pd(half, _mm256_add_pd(e, inverse_e));
+    __m256d s = _mm256_mul_pd(half, _mm256_sub_pd(e, inverse_e));
+
+    // Horner scheme of sum_{i=0}^{8} v^{2i+1} / (2i+1)!
+    __m256d v2 = _mm256_mul_pd(v, v);
+    __m256d q = _mm256_set1_pd(1.0 / 355687428096000.0);
+    const GLdouble odd_inverse_factorials[] =
+    {
+        1.0 / 1307674368000.0, 1.0 / 6227020800.0, 1.0 / 39916800.0, 1.0 / 362880.0,
+        1.0 / 5040.0, 1.0 / 120.0, 1.0 / 6.0, 1.0
+    };
+    for (GLuint i = 0; i < 8; i++)
+    {
+        q = _mm256_fmadd_pd(q, v2, _mm256_set1_pd(odd_inverse_factorials[i]));
+    }
+    q = _mm256_mul_pd(q, v);
+
+    __m256d absolute_v = _mm256_andnot_pd(_mm256_set1_pd(-0.0), v);
+    __m256d small = _mm256_cmp_pd(absolute_v, one, _CMP_LT_OQ);
+    s = _mm256_blendv_pd(s, q, small);
+
+    _mm256_storeu_pd(sinh_x, s);
+    _mm256_storeu_pd(cosh_x, c);
+}
+#endif
+
+// batch evaluation of all blending functions
+GLboolean BlendingFunctionUtil::EvaluateBatch(const GLdouble* u, GLuint count, GLuint max_order, Matrix<GLdouble>& table) const
+{
+    if (max_order > 2 || (count && !u))
+    {
+        return GL_FALSE;
+    }
+
+    GLuint row_count = 4 * (max_order + 1);
+    if (table.GetColumnCount() != count)
+        table.ResizeColumns(count);
+    if (table.GetRowCount() != row_count)
+        table.ResizeRows(row_count);
+
+    // parameter values are processed in chunks, such that the hyperbolic terms at u and at
+    // w = alpha - u fit on the stack
+    const GLuint chunk_size = 64;
+    GLdouble w[chunk_size];
+    GLdouble sinh_u[chunk_size], cosh_u[chunk_size];
+    GLdouble sinh_w[chunk_size], cosh_w[chunk_size];
+
+    for (GLuint first = 0; first < count; first += chunk_size)
+    {
+        GLuint size = std::min(chunk_size, count - first);
+
+        for (GLuint j = 0; j < size; j++)
+        {
+            w[j] = _alpha - u[first + j];
+        }
+
+        GLuint j = 0;
+
+#if CAGD_AVX2_KERNELS
+        if (ProcessorSupportsAVX2())
+        {
+            for (; j + 4 <= size; j += 4)
+            {
+                _hyperbolicFunctions4(u + first + j, sinh_u + j, cosh_u + j);
+                _hyperbolicFunctions4(w + j, sinh_w + j, cosh_w + j);
+            }
+        }
+#endif
+        for (; j < size; j++)
+        {
+            sinh_u[j] = sinh(u[first + j]);
+            cosh_u[j] = cosh(u[first + j]);
+            sinh_w[j] = sinh(w[j]);
+            cosh_w[j] = cosh(w[j]);
+        }
+
+        for (j = 0; j < size; j++)
+        {
+            GLdouble out[3][4];
+            _evaluateAll(u[first + j], sinh_u[j], cosh_u[j], sinh_w[j], cosh_w[j], max_order, out);
+
+            for (GLuint r = 0; r <= max_order; r++)
+            {
+                for (GLuint i = 0; i < 4; i++)
+                {
+                    table(4 * r + i, first + j) = out[r][i];
+                }
+            }
+        }
+    }
+
+    return GL_TRUE;
+}
+
+// forward stepping
+BlendingFunctionUtil::UniformStepper::UniformStepper(
+        const BlendingFunctionUtil& util, GLdouble u_0, GLdouble du, GLuint resynchronization_period)
+    : _util(util)
+    , _u_0(u_0), _du(du)
+    , _exp_du(exp(du)), _exp_minus_du(exp(-du))
+    , _step(0), _resynchronization_period(std::max(resynchronization_period, 1u))
+    , _u(u_0), _exp_u(exp(u_0)), _exp_minus_u(exp(-u_0))
+{
+}
+
+GLdouble BlendingFunctionUtil::UniformStepper::GetParameter() const
+{
+    return _u;
+}
+
+GLboolean BlendingFunctionUtil::UniformStepper::Evaluate(GLuint max_order, GLdouble out[3][4]) const
+{
+    if (max_order > 2)
+    {
+        return GL_FALSE;
+    }
+
+    // exp(w) and exp(-w) are products of exponentials, thus they are accurate also if alpha is large
+    GLdouble exp_w = _util._exp_alpha * _exp_minus_u;
+    GLdouble exp_minus_w = _util._exp_minus_alpha * _exp_u;
+
+    _util._evaluateAll(_u,
+                       0.5 * (_exp_u - _exp_minus_u), 0.5 * (_exp_u + _exp_minus_u),
+                       0.5 * (exp_w - exp_minus_w), 0.5 * (exp_w + exp_minus_w),
+                       max_order, out);
+
+    return GL_TRUE;
+}
+
+GLvoid BlendingFunctionUtil::UniformStepper::Advance()
+{
+    // the parameter value itself is not accumulated, hence it is exact up to a single rounding
+    _step++;
+    _u = _u_0 + _step * _du;
+
+    if (_step % _resynchronization_period == 0)
+    {
+        _exp_u = exp(_u);
+        _exp_minus_u = exp(-_u);
+    }
+    else
+    {
+        // exp(u + du) = exp(u) exp(du) and exp(-u - du) = exp(-u) exp(-du), i.e., the relative
+        // rounding errors grow only linearly with the number of steps
+        _exp_u *= _exp_du;
+        _exp_minus_u *= _exp_minus_du;
+    }
+}
+
+// table of a uniform subdivision by forward stepping
+GLboolean BlendingFunctionUtil::EvaluateUniform(
+        GLdouble u_min, GLdouble u_max, GLuint count, GLuint max_order,
+        Matrix<GLdouble>& table, GLuint resynchronization_period) const
+{
+    if (max_order > 2 || count < 2)
+    {
+        return GL_FALSE;
+    }
+
+    GLuint row_count = 4 * (max_order + 1);
+    if (table.GetColumnCount() != count)
+        table.ResizeColumns(count);
+    if (table.GetRowCount() != row_count)
+        table.ResizeRows(row_count);
+
+    GLdouble du = (u_max - u_min) / (count - 1);
+    UniformStepper stepper(*this, u_min, du, resynchronization_period);
+
+    for (GLuint k = 0; k < count; k++, stepper.Advance())
+    {
+        GLdouble out[3][4];
+
+        // rounding may carry the last parameter value beyond the end of the domain, in that
+        // case the clamped value is evaluated directly
+        if (stepper.GetParameter() > u_max)
+        {
+            EvaluateAll(u_max, max_order, out);
+        }
+        else
+        {
+            stepper.Evaluate(max_order, out);
+        }
+
+        for (GLuint r = 0; r <= max_order; r++)
+        {
+            for (GLuint i = 0; i < 4; i++)
+            {
+                table(4 * r + i, k) = out[r][i];
+            }
+        }
+    }
+
+    return GL_TRUE;
+}
+
+// accuracy report of the forward stepping
+GLdouble BlendingFunctionUtil::UniformSteppingError(GLuint count, GLuint max_order, GLuint resynchronization_period) const
+{
+    Matrix<GLdouble> table;
+    if (!EvaluateUniform(0.0, _alpha, count, max_order, table, resynchronization_period))
+    {
+        return numeric_limits<GLdouble>::infinity();
+    }
+
+    GLdouble du = _alpha / (count - 1);
+    GLdouble error = 0.0;
+
+    for (GLuint k = 0; k < count; k++)
+    {
+        GLdouble out[3][4];
+        EvaluateAll(std::min(k * du, _alpha), max_order, out);
+
+        for (GLuint r = 0; r <= max_order; r++)
+        {
+            for (GLuint i = 0; i < 4; i++)
+            {
+                error = std::max(error, fabs(table(4 * r + i, k) - out[r][i]));
+            }
+        }
+    }
+
+    return error;
+}
+
+// accuracy report of the fused evaluation
+GLdouble BlendingFunctionUtil::BatchEvaluationError(GLuint count, GLuint max_order) const
+{
+    if (max_order > 2 || count < 2)
+    {
+        return numeric_limits<GLdouble>::infinity();
+    }
+
+    vector<GLdouble> u(count);
+    GLdouble du = _alpha / (count - 1);
+    for (GLuint k = 0; k < count; k++)
+    {
+        u[k] = std::min(k * du, _alpha);
+    }
+
+    Matrix<GLdouble> table;
+    if (!EvaluateBatch(u.data(), count, max_order, table))
+    {
+        return numeric_limits<GLdouble>::infinity();
+    }
+
+    typedef GLdouble (BlendingFunctionUtil::*ScalarFunction)(GLdouble) const;
+    static const ScalarFunction scalar_functions[3][4] =
+    {
+        {&BlendingFunctionUtil::blendingFunction00, &BlendingFunctionUtil::blendingFunction01,
+         &BlendingFunctionUtil::blendingFunction02, &BlendingFunctionUtil::blendingFunction03},
+        {&BlendingFunctionUtil::blendingFunction10, &BlendingFunctionUtil::blendingFunction11,
+         &BlendingFunctionUtil::blendingFunction12, &BlendingFunctionUtil::blendingFunction13},
+        {&BlendingFunctionUtil::blendingFunction20, &BlendingFunctionUtil::blendingFunction21,
+         &BlendingFunctionUtil::blendingFunction22, &BlendingFunctionUtil::blendingFunction23}
+    };
+
+    GLdouble error = 0.0;
+
+    for (GLuint k = 0; k < count; k++)
+    {
+        for (GLuint r = 0; r <= max_order; r++)
+        {
+            for (GLuint i = 0; i < 4; i++)
+            {
+                error = std::max(error, fabs(table(4 * r + i, k) - (this->*scalar_functions[r][i])(u[k])));
+            }
+        }
+    }
+
+    return error;
 }
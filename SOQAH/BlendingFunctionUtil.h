@@ -7,9 +7,44 @@ namespace cagd
     class BlendingFunctionUtil
     {
     public:
+        // forward-stepping evaluation along the uniform subdivision u_k = u_0 + k * du: exp(u) and
+        // exp(-u) at u_{k+1} follow from their values at u_k by a single multiplication, and the
+        // hyperbolic terms at u and at alpha - u are combined from them, thus a step needs no libm
+        // call; in order to bound the drift of rounding errors, the exponentials are recalculated
+        // directly after every resynchronization_period steps
+        class UniformStepper
+        {
+        public:
+            // special constructor
+            UniformStepper(const BlendingFunctionUtil& util, GLdouble u_0, GLdouble du,
+                           GLuint resynchronization_period = 16);
+
+            // current parameter value
+            GLdouble GetParameter() const;
+
+            // evaluates every blending function at the current parameter value,
+            // see BlendingFunctionUtil::EvaluateAll
+            GLboolean Evaluate(GLuint max_order, GLdouble out[3][4]) const;
+
+            // moves to the next parameter value
+            GLvoid Advance();
+
+        protected:
+            const BlendingFunctionUtil& _util;
+            GLdouble                    _u_0, _du;
+            GLdouble                    _exp_du, _exp_minus_du;
+            GLuint                      _step, _resynchronization_period;
+            GLdouble                    _u, _exp_u, _exp_minus_u;
+        };
+
         // special constructor
         BlendingFunctionUtil(GLdouble alpha = 1.0);
 
+        // setter/getter for alpha, the constants that depend only on alpha are
+        // recalculated whenever it is changed
+        GLvoid setAlpha(GLdouble alpha);
+        GLdouble getAlpha() const;
+
         GLdouble getConstant2() const;
         GLdouble getConstant3() const;
         GLdouble getConstant4() const;
@@ -28,7 +63,60 @@ namespace cagd
         GLdouble blendingFunction21(GLdouble u) const;
         GLdouble blendingFunction22(GLdouble u) const;
         GLdouble blendingFunction23(GLdouble u) const;
+
+        // evaluates every blending function and its derivatives up to the given order
+        // (at most 2) at once, i.e., out[r][i] becomes the r-th order derivative of the
+        // i-th blending function; the hyperbolic terms at u and at alpha - u are shared by
+        // all functions, so a single call needs only two sinh and two cosh evaluations
+        GLboolean EvaluateAll(GLdouble u, GLuint max_order, GLdouble out[3][4]) const;
+
+        // batch variant of the method above for an array of parameter values: afterwards the
+        // row 4 * r + i of the table stores the r-th order derivative of the i-th blending
+        // function at every parameter value, i.e., the table is resized (only if necessary) to
+        // 4 * (max_order + 1) rows and count columns; if the processor supports AVX2 (checked
+        // at run time), sinh and cosh (at u and at alpha - u) are evaluated for four parameter
+        // values at a time, otherwise the scalar functions of the standard library are used
+        GLboolean EvaluateBatch(const GLdouble* u, GLuint count, GLuint max_order, Matrix<GLdouble>& table) const;
+
+        // fills the table of EvaluateBatch for the uniform subdivision u_k = min(u_min + k * du, u_max),
+        // where du = (u_max - u_min) / (count - 1) and k = 0, 1,..., count - 1, by forward stepping
+        GLboolean EvaluateUniform(GLdouble u_min, GLdouble u_max, GLuint count, GLuint max_order,
+                                  Matrix<GLdouble>& table, GLuint resynchronization_period = 16) const;
+
+        // accuracy report of the forward stepping: returns the maximum absolute difference between
+        // EvaluateUniform and EvaluateAll over the uniform subdivision of [0, alpha]
+        GLdouble UniformSteppingError(GLuint count, GLuint max_order = 2, GLuint resynchronization_period = 16) const;
+
+        // accuracy report of the fused evaluation: returns the maximum absolute difference between
+        // EvaluateBatch and the scalar functions blendingFunction00,..., blendingFunction23 over the
+        // uniform subdivision of [0, alpha], it stays at the level of rounding errors also for large
+        // values of alpha
+        GLdouble BatchEvaluationError(GLuint count, GLuint max_order = 2) const;
+
     protected:
         GLdouble _alpha{0.0};
+
+        // constants that depend only on alpha
+        GLdouble _alpha2{0.0};
+        GLdouble _sinh_alpha{0.0};
+        GLdouble _cosh_alpha{0.0};
+        GLdouble _exp_alpha{0.0};
+        GLdouble _exp_minus_alpha{0.0};
+        GLdouble _constant2{0.0};
+        GLdouble _constant3{0.0};
+        GLdouble _constant4{0.0};
+
+        // the common part of EvaluateAll, EvaluateBatch and the forward stepping, where w = alpha - u
+        GLvoid _evaluateAll(
+                GLdouble u, GLdouble sinh_u, GLdouble cosh_u,
+                GLdouble sinh_w, GLdouble cosh_w,
+                GLuint max_order, GLdouble out[3][4]) const;
+
+        // calculates the values of the 3rd blending function and its derivatives at u,
+        // where w = alpha - u
+        GLvoid _evaluateSecondFunction(
+                GLdouble u, GLdouble sinh_u, GLdouble cosh_u,
+                GLdouble w, GLdouble sinh_w, GLdouble cosh_w,
+                GLuint max_order, GLdouble values[3]) const;
     };
 }
@@ -1,5 +1,7 @@
 #include "SOQAHArcs3.h"
+#include "BlendingFunctionTableCache.h"
 
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
@@ -14,6 +16,7 @@ SOQAHArcs3::SOQAHArcs3(
     : LinearCombination3(0.0, alpha, data_count, data_usage_flag)
     , _alpha(alpha)
     , _data_count(data_count)
+    , _blending_function_util(alpha)
 {
 }
 
@@ -24,53 +27,74 @@ GLboolean SOQAHArcs3::BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble> &va
     {
         return GL_FALSE;
     }
-    values(0) = _blending_function_util.blendingFunction00(u);
-    values(1) = _blending_function_util.blendingFunction01(u);
-    values(2) = _blending_function_util.blendingFunction02(u);
-    values(3) = _blending_function_util.blendingFunction03(u);
+
+    GLdouble F[3][4];
+    _blending_function_util.EvaluateAll(u, 0, F);
+
+    values(0) = F[0][0];
+    values(1) = F[0][1];
+    values(2) = F[0][2];
+    values(3) = F[0][3];
     return GL_TRUE;
 }
 
-GLboolean SOQAHArcs3::CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, LinearCombination3::Derivatives &d) const
+GLboolean SOQAHArcs3::BlendingFunctionTable(const GLdouble* u, GLuint count, GLuint max_order_of_derivatives, SharedTable &table) const
 {
-    d.ResizeRows(max_order_of_derivatives + 1);
-    d.LoadNullVectors();
-
-    Matrix<GLdouble> dF(max_order_of_derivatives + 1, _data.GetRowCount());
-
-    // We always evaluate the function's value (0th order derivative)
-    dF(0, 0) = _blending_function_util.blendingFunction00(u);
-    dF(0, 1) = _blending_function_util.blendingFunction01(u);
-    dF(0, 2) = _blending_function_util.blendingFunction02(u);
-    dF(0, 3) = _blending_function_util.blendingFunction03(u);
-
-    // Evaluate the 1st order of derivatives if required
-    if (max_order_of_derivatives >= 1)
+    // the table layout requires exactly four control points, while derivatives of order higher
+    // than 2 are not supported by the batch evaluation
+    if (_data.GetRowCount() != 4 || max_order_of_derivatives > 2)
     {
-        dF(1, 0) = _blending_function_util.blendingFunction10(u);
-        dF(1, 1) = _blending_function_util.blendingFunction11(u);
-        dF(1, 2) = _blending_function_util.blendingFunction12(u);
-        dF(1, 3) = _blending_function_util.blendingFunction13(u);
+        return GL_FALSE;
     }
 
-    // Evaluate the 2nd order of derivatives if required
-    if(max_order_of_derivatives >= 2)
+    for (GLuint k = 0; k < count; k++)
     {
-        dF(2, 0) = _blending_function_util.blendingFunction20(u);
-        dF(2, 1) = _blending_function_util.blendingFunction21(u);
-        dF(2, 2) = _blending_function_util.blendingFunction22(u);
-        dF(2, 3) = _blending_function_util.blendingFunction23(u);
+        if (u[k] < 0 || u[k] > _alpha)
+        {
+            return GL_FALSE;
+        }
     }
 
+    // uniform subdivisions are served by the shared cache
+    table = BlendingFunctionTableCache::Evaluate(_blending_function_util, u, count, max_order_of_derivatives);
+    return table != nullptr;
+}
 
-    for (GLuint order = 0; order <= max_order_of_derivatives; order++)
+GLboolean SOQAHArcs3::InterpolationSignature(std::vector<GLdouble>& signature) const
+{
+    signature.push_back(_alpha);
+    return GL_TRUE;
+}
+
+GLboolean SOQAHArcs3::CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, LinearCombination3::Derivatives &d) const
+{
+#ifndef NDEBUG
+    // derivatives that already have the required size must not be resized (debug builds only)
+    GLboolean d_is_sized = (d.GetRowCount() == max_order_of_derivatives + 1);
+    GLulong   allocation_count = MatrixStorageAllocationCount();
+#endif
+
+    if (_data.GetRowCount() != 4)
     {
-        for (GLuint i = 0; i <= 3; i++)
-        {
-            d[order] += _data[i] * dF(order, i);
-        }
+        return GL_FALSE;
     }
 
+    d.ResizeRows(max_order_of_derivatives + 1);
+    d.LoadNullVectors();
+
+    // the blending function table of an arc is of fixed size, hence it lives on the stack, while
+    // the kernel reads the four control points in place, i.e., evaluation performs no heap
+    // allocation; every required order is evaluated at once, while derivatives of order higher
+    // than 2 remain null vectors
+    GLuint max_order = std::min(max_order_of_derivatives, 2u);
+
+    GLdouble dF[3][4];
+    _blending_function_util.EvaluateAll(u, max_order, dF);
+
+    _SumDerivatives<4>(_data.GetData(), dF, max_order, d);
+
+    assert(!d_is_sized || MatrixStorageAllocationCount() == allocation_count);
+
     return GL_TRUE;
 }
 
@@ -88,5 +112,7 @@ GLboolean SOQAHArcs3::SetAlpha(GLdouble alpha)
         return GL_FALSE;
     }
     _alpha = alpha;
+    _blending_function_util.setAlpha(alpha);
+    SetDefinitionDomain(0.0, alpha);
     return GL_TRUE;
 }
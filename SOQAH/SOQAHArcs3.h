@@ -17,8 +17,14 @@ namespace cagd
                 GLenum data_usage_flag = GL_STATIC_DRAW);
 
         GLboolean BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble> &values) const;
+
+        // batch-basis hook of the image generation
+        GLboolean BlendingFunctionTable(const GLdouble* u, GLuint count, GLuint max_order_of_derivatives, SharedTable &table) const;
         GLboolean CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives &d) const;
 
+        // interpolation-plan hook, the blending functions are determined by alpha
+        GLboolean InterpolationSignature(std::vector<GLdouble>& signature) const;
+
         // gette/setter for alpha
         GLdouble GetAlpha();
         GLboolean SetAlpha(GLdouble alpha);
@@ -26,7 +32,32 @@ namespace cagd
     protected:
         GLdouble _alpha{0.0};
         GLuint   _data_count{4};
+
+        // evaluation kernel of a control polygon of compile-time size, that is read in place from the
+        // storage of _data, see SOQAHPatch3::_SumPartialDerivatives
+        template <GLuint N>
+        static GLvoid _SumDerivatives(
+                const DCoordinate3* control_points,
+                const GLdouble (&blending_values)[3][N], GLuint max_order,
+                Derivatives& d);
     private:
         BlendingFunctionUtil _blending_function_util;
     };
+
+    template <GLuint N>
+    inline GLvoid SOQAHArcs3::_SumDerivatives(
+            const DCoordinate3* control_points,
+            const GLdouble (&blending_values)[3][N], GLuint max_order,
+            Derivatives& d)
+    {
+        for (GLuint order = 0; order <= max_order; order++)
+        {
+            DCoordinate3 sum;
+            for (GLuint i = 0; i < N; i++)
+            {
+                sum += control_points[i] * blending_values[order][i];
+            }
+            d[order] = sum;
+        }
+    }
 }
@@ -1,8 +1,17 @@
 #include "SOQAHCompositeSurface3.h"
 #include "SOQAHCompositeSurface3.h"
+#include "../Core/Parallelism.h"
+
+#include <algorithm>
+#include <map>
 
 using namespace cagd;
 
+// minimal number of interpolation problems per thread of InterpolateAll, the solution of a problem
+// consists of triangular solves with small collocation matrices, thus a few problems already
+// outweigh the start-up of a thread
+static const GLuint INTERPOLATION_PROBLEMS_PER_THREAD = 8;
+
 GLboolean SOQAHCompositeSurface3::PatchAttributes::UpdatePatch
     (
     GLuint iso_line_count,
@@ -181,6 +190,139 @@ GLboolean SOQAHCompositeSurface3::SetPatchPoint(GLuint patch_index, GLuint point
     return _patches[patch_index]->_patch->SetData(point_ind_1, point_ind_2, point);
 }
 
+GLboolean SOQAHCompositeSurface3::FitPatch(GLuint patch_index, const std::vector<DCoordinate3>& points,
+                                           GLdouble smoothing_weight,
+                                           TensorProductSurface3::FittingStatistics* statistics)
+{
+    if (patch_index >= _patches.size())
+    {
+        return GL_FALSE;
+    }
+
+    if (!_patches[patch_index]->_patch->UpdateDataForLeastSquaresFitting(points, smoothing_weight, statistics))
+    {
+        return GL_FALSE;
+    }
+
+    return RefreshNeighbours(patch_index);
+}
+
+GLboolean SOQAHCompositeSurface3::InterpolateAll(const std::vector<InterpolationProblem>& problems)
+{
+    // concurrent writes to the same patch would race
+    std::vector<GLboolean> is_used(_patches.size(), GL_FALSE);
+    for (const InterpolationProblem& problem : problems)
+    {
+        if (problem._patch_index >= _patches.size() || is_used[problem._patch_index])
+        {
+            return GL_FALSE;
+        }
+        is_used[problem._patch_index] = GL_TRUE;
+    }
+
+    GLuint problem_count = static_cast<GLuint>(problems.size());
+    std::vector<Matrix<DCoordinate3>> control_nets(problem_count);
+    std::vector<GLboolean> is_solved(problem_count, GL_FALSE);
+
+    // the plans are looked up before the parallel loop, problems of equal signatures and knot vectors
+    // (usually all of them) share their plans without locking the plan cache again
+    std::vector<InterpolationPlanCache::Plan> u_plans(problem_count), v_plans(problem_count);
+    std::map<std::vector<GLdouble>, GLuint> first_problem_of_key;
+    std::vector<GLdouble> key;
+
+    for (GLuint k = 0; k < problem_count; ++k)
+    {
+        const InterpolationProblem& problem = problems[k];
+        const SOQAHPatch3& patch = *_patches[problem._patch_index]->_patch;
+
+        // key: u-signature, u-knots, v-signature, v-knots, the lengths of the signatures are fixed
+        key.clear();
+        GLboolean is_shareable = patch.UInterpolationSignature(key);
+        key.insert(key.end(), problem._u_knots.GetData(), problem._u_knots.GetData() + problem._u_knots.GetColumnCount());
+        is_shareable = patch.VInterpolationSignature(key) && is_shareable;
+        key.insert(key.end(), problem._v_knots.GetData(), problem._v_knots.GetData() + problem._v_knots.GetRowCount());
+
+        if (is_shareable)
+        {
+            auto found = first_problem_of_key.find(key);
+            if (found != first_problem_of_key.end())
+            {
+                u_plans[k] = u_plans[found->second];
+                v_plans[k] = v_plans[found->second];
+                continue;
+            }
+        }
+
+        if (!patch.InterpolationPlans(problem._u_knots, problem._v_knots, u_plans[k], v_plans[k]))
+        {
+            continue;
+        }
+
+        if (is_shareable)
+        {
+            first_problem_of_key.emplace(key, k);
+        }
+    }
+
+    // every solve is a work item of equal cost, the team is sized by the number of problems
+    [[maybe_unused]] GLint thread_count = ParallelThreadCount(problem_count, INTERPOLATION_PROBLEMS_PER_THREAD);
+
+    #pragma omp parallel for schedule(static) num_threads(thread_count) if(thread_count > 1)
+    for (GLint signed_k = 0; signed_k < (GLint)problem_count; ++signed_k)
+    {
+        GLuint k = (GLuint)signed_k;
+        const InterpolationProblem& problem = problems[k];
+        const SOQAHPatch3& patch = *_patches[problem._patch_index]->_patch;
+
+        is_solved[k] = patch.SolveInterpolationProblem(
+                u_plans[k], v_plans[k], problem._data_points, control_nets[k]);
+    }
+
+    GLboolean ok = GL_TRUE;
+
+    for (GLuint k = 0; k < problem_count; ++k)
+    {
+        if (!is_solved[k])
+        {
+            ok = GL_FALSE;
+            continue;
+        }
+
+        SOQAHPatch3& patch = *_patches[problems[k]._patch_index]->_patch;
+        for (GLuint i = 0; i < control_nets[k].GetRowCount(); ++i)
+        {
+            for (GLuint j = 0; j < control_nets[k].GetColumnCount(); ++j)
+            {
+                patch(i, j) = control_nets[k](i, j);
+            }
+        }
+    }
+
+    for (GLuint k = 0; k < problem_count; ++k)
+    {
+        if (is_solved[k])
+        {
+            ok = RefreshNeighbours(problems[k]._patch_index) && ok;
+        }
+    }
+
+    return ok;
+}
+
+GLboolean SOQAHCompositeSurface3::ExportImages(const std::string& file_name, MeshExporter::Format format) const
+{
+    std::vector<const TriangulatedMesh3*> images;
+    images.reserve(_patches.size());
+
+    for (auto patch : _patches)
+    {
+        images.push_back(patch->_image_of_patch);
+    }
+
+    MeshExporter exporter(format);
+    return exporter.Export(file_name, images);
+}
+
 GLboolean SOQAHCompositeSurface3::JoinPatches(GLuint ind1, Direction dir1, GLuint ind2, Direction dir2)
 {
     GLboolean ok = GL_TRUE;
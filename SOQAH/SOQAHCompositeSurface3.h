@@ -2,6 +2,7 @@
 
 #include "SOQAHPatch3.h"
 #include "../Core/Materials.h"
+#include "../Core/MeshExporters.h"
 
 #include <vector>
 
@@ -55,6 +56,15 @@ public:
         void ApplyMaterial(GLuint materialIndex);
     };
 
+    // data of an independent interpolation problem, see TensorProductSurface3::UpdateDataForInterpolation
+    struct InterpolationProblem
+    {
+        GLuint                  _patch_index{0};
+        RowMatrix<GLdouble>     _u_knots{4};
+        ColumnMatrix<GLdouble>  _v_knots{4};
+        Matrix<DCoordinate3>    _data_points{4, 4};
+    };
+
     SOQAHCompositeSurface3(GLuint patch_count = 500);
 
     PatchAttributes* AppendPatch();
@@ -75,6 +85,23 @@ public:
     GLboolean GetPatchPoint(GLuint patch_index, GLuint point_ind_1, GLuint point_ind_2, DCoordinate3& point);
     GLboolean SetPatchPoint(GLuint patch_index, GLuint point_ind_1, GLuint point_ind_2, const DCoordinate3& point);
 
+    // least-squares fit of a patch to a point cloud (e.g. scanned samples or the vertices of a loaded
+    // mesh), the samples are parameterized over the best fit plane, then the neighbours are refreshed
+    GLboolean FitPatch(GLuint patch_index, const std::vector<DCoordinate3>& points,
+                       GLdouble smoothing_weight = 0.0,
+                       TensorProductSurface3::FittingStatistics* statistics = nullptr);
+
+    // solves the given interpolation problems concurrently by the tessellation threads (see Parallelism.h),
+    // since the solution of a problem relies only on the reentrant const methods of its patch; the new
+    // control nets are stored afterwards, then the neighbours of the updated patches are refreshed in
+    // the order of the problems; the patch indices have to be distinct; the patches of failed problems
+    // remain unchanged, and the method returns GL_FALSE if any of the problems failed
+    GLboolean InterpolateAll(const std::vector<InterpolationProblem>& problems);
+
+    // writes the images of the patches into a single file, the images are streamed one after the
+    // other without building a merged mesh; patches without an image are skipped
+    GLboolean ExportImages(const std::string& file_name, MeshExporter::Format format = MeshExporter::Format::OFF) const;
+
     GLboolean JoinPatches(GLuint ind1, Direction dir1, GLuint ind2, Direction dir2);
     GLboolean ContinuePatch(GLuint ind, Direction dir);
     GLboolean MergePatches(GLuint ind1, Direction dir1, GLuint ind2, Direction dir2);
@@ -1,4 +1,5 @@
 #include "SOQAHPatch3.h"
+#include "BlendingFunctionTableCache.h"
 #include <iostream>
 
 using namespace std;
@@ -7,6 +8,7 @@ using namespace cagd;
 SOQAHPatch3::SOQAHPatch3(GLdouble alpha)
     : TensorProductSurface3(0.0, alpha, 0.0, alpha, 4, 4)
     , _alpha(alpha)
+    , _blending_function_util(alpha)
 {
 }
 
@@ -18,10 +20,13 @@ GLboolean SOQAHPatch3::UBlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdoub
     }
     blending_values.ResizeColumns(4);
 
-    blending_values(0) = _blending_function_util.blendingFunction00(u_knot);
-    blending_values(1) = _blending_function_util.blendingFunction01(u_knot);
-    blending_values(2) = _blending_function_util.blendingFunction02(u_knot);
-    blending_values(3) = _blending_function_util.blendingFunction03(u_knot);
+    GLdouble F[3][4];
+    _blending_function_util.EvaluateAll(u_knot, 0, F);
+
+    blending_values(0) = F[0][0];
+    blending_values(1) = F[0][1];
+    blending_values(2) = F[0][2];
+    blending_values(3) = F[0][3];
 
     return GL_TRUE;
 }
@@ -34,14 +39,47 @@ GLboolean SOQAHPatch3::VBlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdoub
     }
     blending_values.ResizeColumns(4);
 
-    blending_values(0) = _blending_function_util.blendingFunction00(v_knot);
-    blending_values(1) = _blending_function_util.blendingFunction01(v_knot);
-    blending_values(2) = _blending_function_util.blendingFunction02(v_knot);
-    blending_values(3) = _blending_function_util.blendingFunction03(v_knot);
+    GLdouble F[3][4];
+    _blending_function_util.EvaluateAll(v_knot, 0, F);
+
+    blending_values(0) = F[0][0];
+    blending_values(1) = F[0][1];
+    blending_values(2) = F[0][2];
+    blending_values(3) = F[0][3];
 
     return GL_TRUE;
 }
 
+GLboolean SOQAHPatch3::UBlendingFunctionTable(const GLdouble* u, GLuint count, GLuint maximum_order_of_derivatives, SharedTable& table) const
+{
+    for(GLuint i = 0; i < count; ++i)
+    {
+        if(u[i] < 0.0 || u[i] > _alpha)
+        {
+            return GL_FALSE;
+        }
+    }
+
+    // the layout of the batch evaluation coincides with the one expected by the hook, uniform
+    // subdivisions are served by the shared cache
+    table = BlendingFunctionTableCache::Evaluate(_blending_function_util, u, count, maximum_order_of_derivatives);
+    return table != nullptr;
+}
+
+GLboolean SOQAHPatch3::VBlendingFunctionTable(const GLdouble* v, GLuint count, GLuint maximum_order_of_derivatives, SharedTable& table) const
+{
+    for(GLuint j = 0; j < count; ++j)
+    {
+        if(v[j] < 0.0 || v[j] > _alpha)
+        {
+            return GL_FALSE;
+        }
+    }
+
+    table = BlendingFunctionTableCache::Evaluate(_blending_function_util, v, count, maximum_order_of_derivatives);
+    return table != nullptr;
+}
+
 GLboolean SOQAHPatch3::CalculatePartialDerivatives
     (
     GLuint max_order_of_derivatives,
@@ -50,48 +88,29 @@ GLboolean SOQAHPatch3::CalculatePartialDerivatives
     PartialDerivatives &partial_derivatives
     ) const
 {
-    if(u < 0.0 || u > _alpha || v < 0.0 || v > _alpha || max_order_of_derivatives > 1)
+    if(u < 0.0 || u > _alpha || v < 0.0 || v > _alpha || max_order_of_derivatives > 1 ||
+       _data.GetRowCount() != 4 || _data.GetColumnCount() != 4)
     {
         return GL_FALSE;
     }
 
-    RowMatrix<GLdouble> u_blending_values_0(4), u_blending_values_1(4);
-    u_blending_values_0(0) = _blending_function_util.blendingFunction00(u);
-    u_blending_values_0(1) = _blending_function_util.blendingFunction01(u);
-    u_blending_values_0(2) = _blending_function_util.blendingFunction02(u);
-    u_blending_values_0(3) = _blending_function_util.blendingFunction03(u);
-
-    u_blending_values_1(0) = _blending_function_util.blendingFunction10(u);
-    u_blending_values_1(1) = _blending_function_util.blendingFunction11(u);
-    u_blending_values_1(2) = _blending_function_util.blendingFunction12(u);
-    u_blending_values_1(3) = _blending_function_util.blendingFunction13(u);
-
-    RowMatrix<GLdouble> v_blending_values_0(4), v_blending_values_1(4);
-    v_blending_values_0(0) = _blending_function_util.blendingFunction00(v);
-    v_blending_values_0(1) = _blending_function_util.blendingFunction01(v);
-    v_blending_values_0(2) = _blending_function_util.blendingFunction02(v);
-    v_blending_values_0(3) =_blending_function_util.blendingFunction03(v);
+#ifndef NDEBUG
+    // partial derivatives that already have the required size must not be resized (debug builds only)
+    GLboolean pd_is_sized = (partial_derivatives.GetRowCount() == 2);
+    GLulong   allocation_count = MatrixStorageAllocationCount();
+#endif
 
-    v_blending_values_1(0) = _blending_function_util.blendingFunction10(v);
-    v_blending_values_1(1) = _blending_function_util.blendingFunction11(v);
-    v_blending_values_1(2) = _blending_function_util.blendingFunction12(v);
-    v_blending_values_1(3) = _blending_function_util.blendingFunction13(v);
+    // the blending function tables of a patch are of fixed size, hence they live on the stack, while
+    // the kernel reads the 4x4 control net in place, i.e., evaluation performs no heap allocation;
+    // all functions and their first order derivatives are evaluated at once in both directions
+    GLdouble u_blending_values[3][4], v_blending_values[3][4];
+    _blending_function_util.EvaluateAll(u, 1, u_blending_values);
+    _blending_function_util.EvaluateAll(v, 1, v_blending_values);
 
-    partial_derivatives.ResizeRows(2);
-    partial_derivatives.LoadNullVectors();
+    partial_derivatives.Reset(1);
+    _SumPartialDerivatives<4, 4>(_data.GetData(), u_blending_values, v_blending_values, partial_derivatives);
 
-    for(GLuint row = 0; row < 4; ++row)
-    {
-        DCoordinate3 aux_d0_v, aux_d1_v;
-        for(GLuint column = 0; column < 4; ++column)
-        {
-            aux_d0_v += _data(row, column) * v_blending_values_0(column);
-            aux_d1_v += _data(row, column) * v_blending_values_1(column);
-        }
-        partial_derivatives(0, 0) += aux_d0_v * u_blending_values_0(row);
-        partial_derivatives(1, 0) += aux_d0_v * u_blending_values_1(row);
-        partial_derivatives(1, 1) += aux_d1_v * u_blending_values_0(row);
-    }
+    assert(!pd_is_sized || MatrixStorageAllocationCount() == allocation_count);
 
     return GL_TRUE;
 }
@@ -99,6 +118,7 @@ GLboolean SOQAHPatch3::CalculatePartialDerivatives
 void SOQAHPatch3::set_alpha(double alpha)
 {
     _alpha = alpha;
+    _blending_function_util.setAlpha(alpha);
     SetUInterval(0, _alpha);
     SetVInterval(0, _alpha);
 }
@@ -107,3 +127,15 @@ GLdouble SOQAHPatch3::get_alpha()
 {
     return _alpha;
 }
+
+GLboolean SOQAHPatch3::UInterpolationSignature(std::vector<GLdouble>& signature) const
+{
+    signature.push_back(_alpha);
+    return GL_TRUE;
+}
+
+GLboolean SOQAHPatch3::VInterpolationSignature(std::vector<GLdouble>& signature) const
+{
+    signature.push_back(_alpha);
+    return GL_TRUE;
+}
@@ -12,13 +12,59 @@ namespace cagd
 
         GLboolean UBlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble> &blending_values) const;
         GLboolean VBlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble> &blending_values) const;
+
+        // batch-basis hooks of the separable grid evaluation
+        GLboolean UBlendingFunctionTable(const GLdouble* u, GLuint count, GLuint maximum_order_of_derivatives, SharedTable& table) const;
+        GLboolean VBlendingFunctionTable(const GLdouble* v, GLuint count, GLuint maximum_order_of_derivatives, SharedTable& table) const;
         GLboolean CalculatePartialDerivatives(GLuint max_order_of_derivatives, GLdouble u, GLdouble v, PartialDerivatives& partial_derivatives) const;
 
+        // interpolation-plan hooks, the blending functions of both directions are determined by alpha
+        GLboolean UInterpolationSignature(std::vector<GLdouble>& signature) const;
+        GLboolean VInterpolationSignature(std::vector<GLdouble>& signature) const;
+
         void set_alpha(double alpha);
         GLdouble get_alpha();
     protected:
         GLdouble _alpha;
+
+        // evaluation kernel of a control net of compile-time dimensions, that is read in place from
+        // its row-major storage (i.e., from _data without copying): the row r of the blending value
+        // tables stores the r-th order derivatives of the blending functions, the loops have constant
+        // bounds, thus the compiler can unroll them and keep the partial sums in registers
+        template <GLuint R, GLuint C>
+        static GLvoid _SumPartialDerivatives(
+                const DCoordinate3* control_net,
+                const GLdouble (&u_blending_values)[3][R], const GLdouble (&v_blending_values)[3][C],
+                PartialDerivatives& partial_derivatives);
     private:
         BlendingFunctionUtil _blending_function_util;
     };
+
+    template <GLuint R, GLuint C>
+    inline GLvoid SOQAHPatch3::_SumPartialDerivatives(
+            const DCoordinate3* control_net,
+            const GLdouble (&u_blending_values)[3][R], const GLdouble (&v_blending_values)[3][C],
+            PartialDerivatives& partial_derivatives)
+    {
+        DCoordinate3 d00, d10, d01;
+
+        for (GLuint row = 0; row < R; ++row)
+        {
+            const DCoordinate3 *control_row = control_net + row * C;
+
+            DCoordinate3 aux_d0_v, aux_d1_v;
+            for (GLuint column = 0; column < C; ++column)
+            {
+                aux_d0_v += control_row[column] * v_blending_values[0][column];
+                aux_d1_v += control_row[column] * v_blending_values[1][column];
+            }
+            d00 += aux_d0_v * u_blending_values[0][row];
+            d10 += aux_d0_v * u_blending_values[1][row];
+            d01 += aux_d1_v * u_blending_values[0][row];
+        }
+
+        partial_derivatives(0, 0) = d00;
+        partial_derivatives(1, 0) = d10;
+        partial_derivatives(1, 1) = d01;
+    }
 }
@@ -0,0 +1,468 @@
+#include "SOQAHStreamingArcFitter.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace cagd;
+using namespace std;
+
+const GLuint SOQAHStreamingArcFitter::MINIMAL_WINDOW_SIZE;
+const GLint  SOQAHStreamingArcFitter::TANGENT_HALF_WIDTH;
+const GLuint SOQAHStreamingArcFitter::PARAMETER_CORRECTION_COUNT;
+
+SOQAHStreamingArcFitter::SOQAHStreamingArcFitter(SOQAHCompositeCurve3& curve, GLdouble tolerance,
+                                                 GLdouble alpha, GLuint maximum_window_size)
+    : _curve(curve)
+    , _tolerance(tolerance)
+    , _alpha(alpha)
+    , _maximum_window_size(max(maximum_window_size, 2 * MINIMAL_WINDOW_SIZE))
+    , _blending_function_util(alpha)
+    , _size_limit(_maximum_window_size)
+{
+    _window.reserve(2 * _maximum_window_size);
+    _u.reserve(_maximum_window_size);
+
+    // c'(0) = F_1'(0) (p_1 - p_0)
+    GLdouble F[3][4];
+    _blending_function_util.EvaluateAll(0.0, 1, F);
+    _start_speed_factor = abs(F[1][1]);
+}
+
+GLboolean SOQAHStreamingArcFitter::AddPoints(const DCoordinate3* points, GLuint count)
+{
+    for (GLuint k = 0; k < count; ++k)
+    {
+        _Consume(points[k]);
+
+        // the current arc is fitted at geometrically growing sizes, hence the cost of the tests is
+        // proportional to the number of points; the end tangents are estimated by central differences
+        while (_window.size() - _CurrentFirst() >= _next_test_size + TANGENT_HALF_WIDTH)
+        {
+            if (!_Test(GL_FALSE))
+            {
+                return GL_FALSE;
+            }
+        }
+    }
+
+    return GL_TRUE;
+}
+
+GLboolean SOQAHStreamingArcFitter::AddPoints(const vector<DCoordinate3>& points)
+{
+    return AddPoints(points.data(), static_cast<GLuint>(points.size()));
+}
+
+GLboolean SOQAHStreamingArcFitter::Finish()
+{
+    // the tests continue up to the last point, every step either grows the next fit, or advances,
+    // or shortens the pending arc, hence the loop terminates
+    while (_window.size() > _CurrentFirst())
+    {
+        if (!_Test(GL_TRUE))
+        {
+            return GL_FALSE;
+        }
+    }
+
+    if (_has_pending && !_AppendPending())
+    {
+        return GL_FALSE;
+    }
+
+    _has_start = GL_FALSE;
+    _has_predecessor = GL_FALSE;
+    _predecessor = nullptr;
+    _size_limit = _maximum_window_size;
+
+    return GL_TRUE;
+}
+
+GLuint SOQAHStreamingArcFitter::GetConsumedPointCount() const
+{
+    return _consumed_point_count;
+}
+
+GLuint SOQAHStreamingArcFitter::GetEmittedArcCount() const
+{
+    return _emitted_arc_count;
+}
+
+GLdouble SOQAHStreamingArcFitter::GetMaximumError() const
+{
+    return _maximum_error;
+}
+
+GLvoid SOQAHStreamingArcFitter::_Consume(const DCoordinate3& point)
+{
+    ++_consumed_point_count;
+
+    if (!_has_start)
+    {
+        _start = point;
+        _has_start = GL_TRUE;
+        return;
+    }
+
+    // repeated points would produce zero parameter steps
+    const DCoordinate3 &last = _window.empty() ? _start : _window.back();
+    if (point[0] == last[0] && point[1] == last[1] && point[2] == last[2])
+    {
+        return;
+    }
+
+    _window.push_back(point);
+}
+
+GLuint SOQAHStreamingArcFitter::_CurrentFirst() const
+{
+    return _has_pending ? _pending._count : 0;
+}
+
+DCoordinate3 SOQAHStreamingArcFitter::_Tangent(GLint i, GLint j, GLuint first, const DCoordinate3& start) const
+{
+    GLint last = static_cast<GLint>(_window.size()) - 1;
+
+    const DCoordinate3 &p = i < static_cast<GLint>(first) ? start : _window[min(i, last)];
+    const DCoordinate3 &q = j < static_cast<GLint>(first) ? start : _window[min(j, last)];
+
+    DCoordinate3 tangent = q - p;
+    GLdouble length = tangent.length();
+
+    return length > 0.0 ? tangent / length : tangent;
+}
+
+GLboolean SOQAHStreamingArcFitter::_Fit(GLuint first, GLuint count, const DCoordinate3& start,
+                                        const DCoordinate3* predecessor_control_point, FittedArc& arc,
+                                        GLboolean may_grow)
+{
+    const DCoordinate3 *points = &_window[first];
+
+    // the parameter values of the points
+    _u.resize(count);
+
+    GLdouble length = 0.0;
+    for (GLuint k = 0; k < count; ++k)
+    {
+        length += (points[k] - (k ? points[k - 1] : start)).length();
+        _u[k] = length;
+    }
+
+    if (length == 0.0)
+    {
+        return GL_FALSE;
+    }
+
+    // the first arc is parameterized by chord length, while the fixed start velocity v of the
+    // other ones would be violated by a constant speed, therefore the normalized arc length t is
+    // mapped to u = alpha (beta t + (1 - beta) t^2), where beta = length / (alpha |v|) is chosen
+    // such that du/ds = 1 / |v| at the start point; the mapping is monotone only if beta <= 2,
+    // thus longer arcs are fitted with a clamped beta; these values are only initial guesses, which
+    // are improved by Newton steps if the fit does not satisfy the tolerance
+    GLdouble beta = 1.0;
+    if (predecessor_control_point)
+    {
+        GLdouble speed = _start_speed_factor * (start - *predecessor_control_point).length();
+        beta = speed > 0.0 ? min(length / (_alpha * speed), 2.0) : 1.0;
+    }
+
+    arc._is_extendable = predecessor_control_point && beta < 1.0;
+
+    for (GLuint k = 0; k < count; ++k)
+    {
+        GLdouble t = _u[k] / length;
+        _u[k] = min(max(_alpha * t * (beta + (1.0 - beta) * t), 0.0), _alpha);
+    }
+
+    // the end points lie on the polyline, the end tangents are estimated by differences of the
+    // neighbouring points (central ones, if the window extends beyond the arc), thus
+    //
+    // p_1 = p_0 + s_0 t_0 and p_2 = p_3 - s_1 t_1,
+    //
+    // where s_0 is fixed by the C1 condition if the arc has a predecessor
+    GLint begin = static_cast<GLint>(first), end = begin + static_cast<GLint>(count) - 1;
+
+    DCoordinate3 p_0 = start, p_3 = points[count - 1];
+    DCoordinate3 t_0 = predecessor_control_point ? start - *predecessor_control_point
+                                                 : _Tangent(begin - 1, begin + TANGENT_HALF_WIDTH - 1, first, start);
+    DCoordinate3 t_1 = _Tangent(end - TANGENT_HALF_WIDTH, end + TANGENT_HALF_WIDTH, first, start);
+
+    for (GLuint correction = 0; ; ++correction)
+    {
+        GLboolean is_last = correction == PARAMETER_CORRECTION_COUNT;
+
+        if (!_blending_function_util.EvaluateBatch(_u.data(), count, is_last ? 0 : 2, _table))
+        {
+            return GL_FALSE;
+        }
+
+        // the residuals are linear in the lengths: d_k - (F_0 + F_1) p_0 - (F_2 + F_3) p_3 = s_0 a_k + s_1 b_k,
+        // where a_k = F_1 t_0 and b_k = -F_2 t_1
+        GLdouble aa = 0.0, ab = 0.0, bb = 0.0, ar = 0.0, br = 0.0;
+        for (GLuint k = 0; k < count; ++k)
+        {
+            DCoordinate3 r = points[k] - (_table(0, k) + _table(1, k)) * p_0 - (_table(2, k) + _table(3, k)) * p_3;
+            DCoordinate3 a = _table(1, k) * t_0;
+            DCoordinate3 b = -_table(2, k) * t_1;
+
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            ar += a * r;
+            br += b * r;
+        }
+
+        // the unit tangents imply that bb (and aa without a predecessor) is a sum of squared
+        // blending function values, which vanishes up to rounding errors if the arc covers only its
+        // end point, in this case the default lengths are used
+        GLdouble s_0 = length / 3.0, s_1 = length / 3.0;
+
+        if (predecessor_control_point)
+        {
+            // t_0 already has the proper length
+            s_0 = 1.0;
+            if (bb > numeric_limits<GLdouble>::epsilon())
+            {
+                s_1 = (br - ab) / bb;
+            }
+        }
+        else
+        {
+            GLdouble determinant = aa * bb - ab * ab;
+            if (aa > numeric_limits<GLdouble>::epsilon() && bb > numeric_limits<GLdouble>::epsilon() &&
+                determinant > numeric_limits<GLdouble>::epsilon() * aa * bb)
+            {
+                s_0 = (ar * bb - br * ab) / determinant;
+                s_1 = (aa * br - ab * ar) / determinant;
+            }
+
+            // reversed tangents would produce loops
+            if (s_0 <= 0.0)
+            {
+                s_0 = length / 3.0;
+            }
+        }
+
+        if (s_1 <= 0.0)
+        {
+            s_1 = length / 3.0;
+        }
+
+        arc._control_points[0] = p_0;
+        arc._control_points[1] = p_0 + s_0 * t_0;
+        arc._control_points[2] = p_3 - s_1 * t_1;
+        arc._control_points[3] = p_3;
+        arc._count = count;
+
+        arc._error = 0.0;
+        for (GLuint k = 0; k < count; ++k)
+        {
+            DCoordinate3 point;
+            for (GLuint i = 0; i < 4; ++i)
+            {
+                point += _table(i, k) * arc._control_points[i];
+            }
+            arc._error = max(arc._error, (point - points[k]).length());
+        }
+
+        if (is_last || arc._error <= _tolerance || (may_grow && arc._is_extendable))
+        {
+            break;
+        }
+
+        // Newton steps towards the feet of the perpendiculars of the points
+        for (GLuint k = 0; k < count; ++k)
+        {
+            DCoordinate3 d[3];
+            for (GLuint r = 0; r < 3; ++r)
+            {
+                for (GLuint i = 0; i < 4; ++i)
+                {
+                    d[r] += _table(4 * r + i, k) * arc._control_points[i];
+                }
+            }
+
+            DCoordinate3 difference = d[0] - points[k];
+            GLdouble denominator = d[1] * d[1] + difference * d[2];
+
+            if (denominator > 0.0)
+            {
+                _u[k] = min(max(_u[k] - (difference * d[1]) / denominator, 0.0), _alpha);
+            }
+        }
+    }
+
+    return GL_TRUE;
+}
+
+GLboolean SOQAHStreamingArcFitter::_FitCurrent(GLuint count, FittedArc& arc, GLboolean may_grow)
+{
+    if (_has_pending)
+    {
+        return _Fit(_pending._count, count, _pending._control_points[3], &_pending._control_points[2], arc, may_grow);
+    }
+
+    return _Fit(0, count, _start, _has_predecessor ? &_predecessor_control_point : nullptr, arc, may_grow);
+}
+
+GLboolean SOQAHStreamingArcFitter::_Test(GLboolean is_final)
+{
+    GLuint available = static_cast<GLuint>(_window.size()) - _CurrentFirst();
+    GLuint count = min(available, _next_test_size);
+
+    // neither an arc of the size limit, nor the end of the polyline can be extended
+    GLboolean is_last = count >= _size_limit || (is_final && count == available);
+
+    FittedArc arc;
+    if (!_FitCurrent(count, arc, !is_last))
+    {
+        return GL_FALSE;
+    }
+
+    if (arc._error <= _tolerance)
+    {
+        _accepted = arc;
+
+        if (is_last)
+        {
+            return _Advance(_accepted);
+        }
+
+        _next_test_size = min(count + max(1u, count / 8), _size_limit);
+        return GL_TRUE;
+    }
+
+    if (_accepted._count)
+    {
+        return _AdvanceAccepted();
+    }
+
+    // short arcs may fail due to a large start velocity, thus they are extended
+    if (!is_last && arc._is_extendable)
+    {
+        _next_test_size = min(count + max(1u, count / 8), _size_limit);
+        return GL_TRUE;
+    }
+
+    return _Backtrack();
+}
+
+GLboolean SOQAHStreamingArcFitter::_Backtrack()
+{
+    GLuint available = static_cast<GLuint>(_window.size()) - _CurrentFirst();
+
+    FittedArc shortest;
+    if (!_FitCurrent(min(available, MINIMAL_WINDOW_SIZE), shortest, GL_TRUE))
+    {
+        return GL_FALSE;
+    }
+
+    // if the start velocity is too large even for the shortest fit, a shorter pending arc, which
+    // prescribes a smaller start velocity, may help; thus the pending arc is replaced by its longest
+    // prefix that satisfies the tolerance and covers at most 7/8 of its points (an arc of a single
+    // point always does, since it interpolates its end point)
+    if (shortest._is_extendable && _has_pending && _pending._count > 1)
+    {
+        for (GLuint count = _pending._count - max(1u, _pending._count / 8); count > 0; count -= max(1u, count / 8))
+        {
+            FittedArc shorter;
+            if (!_Fit(0, count, _start, _has_predecessor ? &_predecessor_control_point : nullptr, shorter))
+            {
+                return GL_FALSE;
+            }
+
+            if (shorter._error <= _tolerance || count == 1)
+            {
+                _pending = shorter;
+                _accepted._count = 0;
+                _next_test_size = MINIMAL_WINDOW_SIZE;
+                _size_limit = max(MINIMAL_WINDOW_SIZE, count / 2);
+
+                return GL_TRUE;
+            }
+        }
+    }
+
+    // e.g. at a corner
+    for (GLuint count = min(available, MINIMAL_WINDOW_SIZE - 1); count > 0; --count)
+    {
+        FittedArc arc;
+        if (!_FitCurrent(count, arc))
+        {
+            return GL_FALSE;
+        }
+
+        if (arc._error <= _tolerance || count == 1)
+        {
+            return _Advance(arc);
+        }
+    }
+
+    return GL_FALSE;
+}
+
+GLboolean SOQAHStreamingArcFitter::_Advance(const FittedArc& arc)
+{
+    FittedArc next = arc;
+
+    if (_has_pending && !_AppendPending())
+    {
+        return GL_FALSE;
+    }
+
+    _pending = next;
+    _has_pending = GL_TRUE;
+
+    _accepted._count = 0;
+    _next_test_size = MINIMAL_WINDOW_SIZE;
+    _size_limit = _maximum_window_size;
+
+    return GL_TRUE;
+}
+
+GLboolean SOQAHStreamingArcFitter::_AdvanceAccepted()
+{
+    // the window extends beyond the accepted arc by now, thus its end tangent can be estimated
+    // by central differences
+    FittedArc refined;
+
+    if (_FitCurrent(_accepted._count, refined) && refined._error <= max(_tolerance, _accepted._error))
+    {
+        return _Advance(refined);
+    }
+
+    return _Advance(_accepted);
+}
+
+GLboolean SOQAHStreamingArcFitter::_AppendPending()
+{
+    SOQAHCompositeCurve3::ArcAttributes *arc = _curve.AppendArc();
+    if (!arc || !arc->_arc->SetAlpha(_alpha))
+    {
+        return GL_FALSE;
+    }
+
+    for (GLuint i = 0; i < 4; ++i)
+    {
+        (*arc->_arc)[i] = _pending._control_points[i];
+    }
+
+    if (_predecessor)
+    {
+        _predecessor->_right = arc;
+        arc->_left = _predecessor;
+    }
+
+    _predecessor = arc;
+    _has_predecessor = GL_TRUE;
+    _predecessor_control_point = _pending._control_points[2];
+    _start = _pending._control_points[3];
+
+    _window.erase(_window.begin(), _window.begin() + _pending._count);
+    _has_pending = GL_FALSE;
+
+    ++_emitted_arc_count;
+    _maximum_error = max(_maximum_error, _pending._error);
+
+    return GL_TRUE;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "SOQAHCompositeCurve3.h"
+#include "BlendingFunctionUtil.h"
+
+#include <vector>
+
+namespace cagd
+{
+
+// converts a long sampled polyline into a chain of C1-joined SOQAH arcs appended to a composite
+// curve; the points can be passed in arbitrary chunks, since the fitter keeps only the points that
+// are not yet covered by an appended arc, i.e., about twice the given maximum window size, thus
+// the memory usage does not depend on the length of the polyline
+//
+// the end points of the arcs are points of the polyline, the second control point of an arc is the
+// reflection of the third control point of its predecessor (the same C1 condition as the one used
+// by SOQAHCompositeCurve3::JoinArcs), the direction of the end tangent is estimated from the
+// neighbouring points, while its length is determined by least squares; an arc is extended as
+// long as the distances between the points and their images stay below the tolerance
+//
+// the C1 condition prescribes the start velocity, therefore an arc cannot be much shorter than its
+// predecessor; the last fitted arc is kept back, and it is shortened until its successor can
+// satisfy the tolerance; if the pending arc cannot be shortened any more (e.g. at a corner), the
+// current arc covers fewer points than the minimal window size, in the extreme case only its end
+// point, thus every appended arc satisfies the tolerance at the points it covers
+class SOQAHStreamingArcFitter
+{
+public:
+    // number of points of the first fit of a window
+    static const GLuint MINIMAL_WINDOW_SIZE = 4;
+
+    // the tangent at the i-th point is estimated by the difference of the points i + h and i - h
+    static const GLint  TANGENT_HALF_WIDTH = 2;
+
+    // number of Newton corrections of the parameter values of the points per fit
+    static const GLuint PARAMETER_CORRECTION_COUNT = 3;
+
+    SOQAHStreamingArcFitter(SOQAHCompositeCurve3& curve, GLdouble tolerance,
+                            GLdouble alpha = 1.0, GLuint maximum_window_size = 4096);
+
+    // consumes the next chunk of points, arcs are appended as soon as they are determined
+    GLboolean AddPoints(const DCoordinate3* points, GLuint count);
+    GLboolean AddPoints(const std::vector<DCoordinate3>& points);
+
+    // appends the arcs of the remaining points, then the fitter can be used for a new polyline
+    GLboolean Finish();
+
+    GLuint   GetConsumedPointCount() const;
+    GLuint   GetEmittedArcCount() const;
+
+    // largest distance between a consumed point and its image on the appended arcs, it does not
+    // exceed the tolerance
+    GLdouble GetMaximumError() const;
+
+private:
+    // control points of an arc that covers count points of the window, an empty fit has no points;
+    // an arc is extendable if it is shorter than the start velocity prescribed by its predecessor
+    // suggests
+    struct FittedArc
+    {
+        DCoordinate3    _control_points[4];
+        GLuint          _count{0};
+        GLdouble        _error{0.0};
+        GLboolean       _is_extendable{GL_TRUE};
+    };
+
+    SOQAHCompositeCurve3&               _curve;
+    GLdouble                            _tolerance;
+    GLdouble                            _alpha;
+    GLuint                              _maximum_window_size;
+    BlendingFunctionUtil                _blending_function_util;
+    GLdouble                            _start_speed_factor{0.0};
+
+    // end point and third control point of the last appended arc
+    GLboolean                           _has_start{GL_FALSE};
+    DCoordinate3                        _start;
+    GLboolean                           _has_predecessor{GL_FALSE};
+    DCoordinate3                        _predecessor_control_point;
+    SOQAHCompositeCurve3::ArcAttributes* _predecessor{};
+
+    // the window stores the points of the pending arc followed by the points of the current one
+    std::vector<DCoordinate3>           _window;
+    GLboolean                           _has_pending{GL_FALSE};
+    FittedArc                           _pending;
+
+    // the size of the next fit of the current arc, its largest size and its last fit that satisfied
+    // the tolerance; every shortening of the pending arc limits the size of the current arc to half
+    // of the shortened one, thus the arcs become shorter gradually before corners
+    GLuint                              _next_test_size{MINIMAL_WINDOW_SIZE};
+    GLuint                              _size_limit;
+    FittedArc                           _accepted;
+
+    GLuint                              _consumed_point_count{0};
+    GLuint                              _emitted_arc_count{0};
+    GLdouble                            _maximum_error{0.0};
+
+    // scratch memory of the fits
+    std::vector<GLdouble>               _u;
+    Matrix<GLdouble>                    _table;
+
+    GLvoid    _Consume(const DCoordinate3& point);
+
+    // unit vector between the window points of the given indices, the indices are clamped to the
+    // window, while the ones less than first denote the start point
+    DCoordinate3 _Tangent(GLint i, GLint j, GLuint first, const DCoordinate3& start) const;
+
+    // least-squares arc from the start point to the window point first + count - 1, the
+    // predecessor control point may be null; the parameter values of the points are improved by
+    // Newton steps as long as the tolerance is not satisfied, except for extendable fits of arcs
+    // that may grow, since a longer fit follows them anyway
+    GLboolean _Fit(GLuint first, GLuint count, const DCoordinate3& start,
+                   const DCoordinate3* predecessor_control_point, FittedArc& arc,
+                   GLboolean may_grow = GL_FALSE);
+
+    // index of the first window point of the current arc
+    GLuint    _CurrentFirst() const;
+
+    // fit of the first count points of the current arc
+    GLboolean _FitCurrent(GLuint count, FittedArc& arc, GLboolean may_grow = GL_FALSE);
+
+    // tries the next fit of the current arc and decides whether the arc is complete; during the
+    // streaming the fits are tested only if the window contains the neighbours of their end points,
+    // while the final tests cover the last points of the polyline
+    GLboolean _Test(GLboolean is_final);
+
+    // called if no fit of the current arc satisfies the tolerance: if the start velocity is too large,
+    // the pending arc is shortened, otherwise (or if the pending arc cannot be shortened) the current
+    // arc covers fewer points than the minimal window size
+    GLboolean _Backtrack();
+
+    // the pending arc is appended and the given one becomes pending
+    GLboolean _Advance(const FittedArc& arc);
+    GLboolean _AdvanceAccepted();
+
+    GLboolean _AppendPending();
+};
+
+}